@@ -387,9 +387,13 @@ private:
 // be destroyed before then. Destruction releases all resources.
 class PreambleThrottlerRequest {
 public:
-  // The condition variable is signalled when the request is satisfied.
+  // The condition variable is signalled when the request is satisfied. The
+  // request becomes satisfied with the mutex held, so that a thread waiting on
+  // the condition variable with the mutex can't miss the notification. The
+  // mutex must not be held while constructing the request, as the throttler
+  // may satisfy it synchronously.
   PreambleThrottlerRequest(llvm::StringRef Filename,
-                           PreambleThrottler *Throttler,
+                           PreambleThrottler *Throttler, std::mutex &Mu,
                            std::condition_variable &CV)
       : Throttler(Throttler),
         Satisfied(Throttler == nullptr) {
@@ -397,7 +401,10 @@ public:
     if (!Throttler)
       return;
     ID = Throttler->acquire(Filename, [&] {
-      Satisfied.store(true, std::memory_order_release);
+      {
+        std::lock_guard<std::mutex> Lock(Mu);
+        Satisfied.store(true, std::memory_order_release);
+      }
       CV.notify_all();
     });
   }
@@ -483,7 +490,10 @@ public:
           break;
 
         {
-          Throttle.emplace(FileName, Throttler, ReqCV);
+          // The throttler may satisfy the request from within acquire(), which
+          // locks Mutex. Only stop() clears NextReq, and it also sets Done.
+          Lock.unlock();
+          Throttle.emplace(FileName, Throttler, Mutex, ReqCV);
           std::optional<trace::Span> Tracer;
           // If acquire succeeded synchronously, avoid status jitter.
           if (!Throttle->satisfied()) {
@@ -492,6 +502,7 @@ public:
               Status.PreambleActivity = PreambleAction::Queued;
             });
           }
+          Lock.lock();
           ReqCV.wait(Lock, [&] { return Throttle->satisfied() || Done; });
         }
         if (Done)
@@ -1861,6 +1872,45 @@ DebouncePolicy DebouncePolicy::fixed(clock::duration T) {
   return P;
 }
 
+LimitingPreambleThrottler::LimitingPreambleThrottler(unsigned MaxConcurrent)
+    : MaxConcurrent(MaxConcurrent) {
+  assert(MaxConcurrent > 0 && "Throttler would never grant a request");
+}
+
+PreambleThrottler::RequestID
+LimitingPreambleThrottler::acquire(llvm::StringRef Filename, Callback CB) {
+  std::lock_guard<std::mutex> Lock(Mu);
+  RequestID ID = NextID++;
+  if (Running < MaxConcurrent) {
+    ++Running;
+    // Callbacks are run under the lock, so that none can be invoked after the
+    // corresponding release() returns.
+    CB();
+  } else {
+    Waiting.emplace_back(ID, std::move(CB));
+  }
+  return ID;
+}
+
+void LimitingPreambleThrottler::release(RequestID ID) {
+  std::lock_guard<std::mutex> Lock(Mu);
+  // A request that is still waiting is abandoned, e.g. because its preamble
+  // became stale, and does not hold any resources.
+  auto It = llvm::find_if(Waiting, [&](const auto &W) { return W.first == ID; });
+  if (It != Waiting.end()) {
+    Waiting.erase(It);
+    return;
+  }
+  assert(Running > 0 && "Released more requests than were granted");
+  --Running;
+  if (!Waiting.empty()) {
+    ++Running;
+    Callback Next = std::move(Waiting.back().second);
+    Waiting.pop_back();
+    Next();
+  }
+}
+
 void TUScheduler::profile(MemoryTree &MT) const {
   for (const auto &Elem : fileStats()) {
     MT.detail(Elem.first())
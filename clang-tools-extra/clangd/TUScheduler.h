@@ -22,8 +22,10 @@
 #include "llvm/ADT/StringRef.h"
 #include <chrono>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace clang {
 namespace clangd {
@@ -116,6 +118,26 @@ public:
   //        this would allow the throttler to make better scheduling decisions.
 };
 
+/// A PreambleThrottler that lets at most a fixed number of preambles build at
+/// once. Waiting requests are granted most recent first: the file that was
+/// opened or edited last is usually the one the user is looking at, while
+/// older requests (e.g. for all files open across a branch switch) can wait.
+class LimitingPreambleThrottler : public PreambleThrottler {
+public:
+  explicit LimitingPreambleThrottler(unsigned MaxConcurrent);
+
+  RequestID acquire(llvm::StringRef Filename, Callback) override;
+  void release(RequestID) override;
+
+private:
+  std::mutex Mu;
+  const unsigned MaxConcurrent;
+  unsigned Running = 0;
+  RequestID NextID = 0;
+  /// Requests that have not been granted yet, in the order they arrived.
+  std::vector<std::pair<RequestID, Callback>> Waiting;
+};
+
 enum class PreambleAction {
   Queued,
   Building,
@@ -8,11 +8,13 @@
 
 #include "../index/Serialization.h"
 #include "../index/dex/Dex.h"
+#include "../index/dex/PostingList.h"
 #include "benchmark/benchmark.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Regex.h"
+#include <random>
 #include <string>
 
 const char *IndexFilename;
@@ -97,6 +99,52 @@ static void dexBuild(benchmark::State &State) {
 }
 BENCHMARK(dexBuild);
 
+// Generates a posting list over a corpus of Size documents, containing on
+// average every Stride-th document. Synthetic lists do not depend on the index
+// file and measure the iterators in isolation.
+dex::PostingList generatePostingList(dex::DocID Size, unsigned Stride,
+                                     unsigned Seed) {
+  std::mt19937 Generator(Seed);
+  std::vector<dex::DocID> Docs;
+  for (dex::DocID ID = 0; ID < Size; ++ID)
+    if (Generator() % Stride == 0)
+      Docs.push_back(ID);
+  return dex::PostingList(Docs);
+}
+
+constexpr dex::DocID LargeCorpusSize = 4 * 1000 * 1000;
+
+// Intersects a dense posting list with a sparser one, Arg gives the stride of
+// the sparse list.
+static void dexLargeCorpusAnd(benchmark::State &State) {
+  const dex::Corpus Corpus(LargeCorpusSize);
+  const auto Dense = generatePostingList(LargeCorpusSize, 4, 1);
+  const auto Sparse = generatePostingList(LargeCorpusSize, State.range(0), 2);
+  for (auto _ : State)
+    benchmark::DoNotOptimize(
+        consume(*Corpus.intersect(Dense.iterator(), Sparse.iterator())));
+}
+BENCHMARK(dexLargeCorpusAnd)->Arg(16)->Arg(256)->Arg(4096);
+
+// Intersects a dense posting list with the union of several sparse ones, which
+// is the shape of a fuzzy-find query over trigrams and scopes.
+static void dexLargeCorpusAndOr(benchmark::State &State) {
+  const dex::Corpus Corpus(LargeCorpusSize);
+  const auto Dense = generatePostingList(LargeCorpusSize, 4, 1);
+  std::vector<dex::PostingList> Sparse;
+  for (unsigned I = 0; I < 8; ++I)
+    Sparse.push_back(generatePostingList(LargeCorpusSize, 512, 2 + I));
+  for (auto _ : State) {
+    std::vector<std::unique_ptr<dex::Iterator>> Children;
+    for (const auto &PL : Sparse)
+      Children.push_back(PL.iterator());
+    auto Query = Corpus.intersect(Dense.iterator(),
+                                  Corpus.unionOf(std::move(Children)));
+    benchmark::DoNotOptimize(consume(*Query));
+  }
+}
+BENCHMARK(dexLargeCorpusAndOr);
+
 } // namespace
 } // namespace clangd
 } // namespace clang
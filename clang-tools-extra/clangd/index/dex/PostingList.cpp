@@ -25,7 +25,7 @@ public:
   explicit ChunkIterator(const Token *Tok, llvm::ArrayRef<Chunk> Chunks)
       : Tok(Tok), Chunks(Chunks), CurrentChunk(Chunks.begin()) {
     if (!Chunks.empty()) {
-      DecompressedChunk = CurrentChunk->decompress();
+      CurrentChunk->decompress(DecompressedChunk);
       CurrentID = DecompressedChunk.begin();
     }
   }
@@ -93,19 +93,32 @@ private:
     ++CurrentChunk;
     if (CurrentChunk == Chunks.end()) // Reached the end of PostingList.
       return;
-    DecompressedChunk = CurrentChunk->decompress();
+    CurrentChunk->decompress(DecompressedChunk);
     CurrentID = DecompressedChunk.begin();
   }
 
   /// Advances CurrentChunk to the chunk which might contain ID.
+  ///
+  /// Intersections mostly advance by short distances, so the range containing
+  /// ID is found by galloping (probing 1, 2, 4, ... chunks ahead) before the
+  /// binary search. This keeps the cost logarithmic in the distance skipped
+  /// rather than in the number of remaining chunks.
   void advanceToChunk(DocID ID) {
     if ((CurrentChunk != Chunks.end() - 1) &&
         ((CurrentChunk + 1)->Head <= ID)) {
+      auto Low = CurrentChunk + 1;
+      size_t Remaining = Chunks.end() - Low;
+      size_t Step = 1;
+      while (Step < Remaining && Low[Step].Head <= ID) {
+        Low += Step;
+        Remaining -= Step;
+        Step *= 2;
+      }
       CurrentChunk =
-          std::partition_point(CurrentChunk + 1, Chunks.end(),
-                               [&](const Chunk &C) { return C.Head < ID; });
+          std::partition_point(Low + 1, Low + std::min(Step, Remaining),
+                               [&](const Chunk &C) { return C.Head <= ID; });
       --CurrentChunk;
-      DecompressedChunk = CurrentChunk->decompress();
+      CurrentChunk->decompress(DecompressedChunk);
       CurrentID = DecompressedChunk.begin();
     }
   }
@@ -202,17 +215,31 @@ std::optional<DocID> readVByte(llvm::ArrayRef<uint8_t> &Bytes) {
 } // namespace
 
 llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Chunk::decompress() const {
-  llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Result{Head};
+  llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Result;
+  decompress(Result);
+  return Result;
+}
+
+void Chunk::decompress(llvm::SmallVectorImpl<DocID> &Out) const {
+  Out.clear();
+  Out.push_back(Head);
   llvm::ArrayRef<uint8_t> Bytes(Payload);
-  DocID Delta;
-  for (DocID Current = Head; !Bytes.empty(); Current += Delta) {
-    auto MaybeDelta = readVByte(Bytes);
-    if (!MaybeDelta)
-      break;
-    Delta = *MaybeDelta;
-    Result.push_back(Current + Delta);
+  DocID Current = Head;
+  while (!Bytes.empty()) {
+    // Most deltas in dense posting lists fit in a single byte.
+    if (Bytes.front() < 0x80) {
+      if (Bytes.front() == 0)
+        break;
+      Current += Bytes.front();
+      Bytes = Bytes.drop_front();
+    } else {
+      auto MaybeDelta = readVByte(Bytes);
+      if (!MaybeDelta)
+        break;
+      Current += *MaybeDelta;
+    }
+    Out.push_back(Current);
   }
-  return llvm::SmallVector<DocID, Chunk::PayloadSize + 1>{Result};
 }
 
 PostingList::PostingList(llvm::ArrayRef<DocID> Documents)
@@ -352,6 +352,15 @@ opt<unsigned> WorkerThreadsCount{
     init(getDefaultAsyncThreadsCount()),
 };
 
+opt<unsigned> PreambleBuildLimit{
+    "preamble-build-limit",
+    cat(Misc),
+    desc("Maximum number of preambles built concurrently. The most recently "
+         "opened or edited files are built first. 0 means no limit"),
+    init(0),
+    Hidden,
+};
+
 opt<Path> IndexFile{
     "index-file",
     cat(Misc),
@@ -941,6 +950,11 @@ clangd accepts flags on the commandline, and in the CLANGD_FLAGS environment var
       Sync);
   Opts.StaticIndex = PAI.get();
   Opts.AsyncThreadsCount = WorkerThreadsCount;
+  std::unique_ptr<PreambleThrottler> Throttler;
+  if (PreambleBuildLimit) {
+    Throttler = std::make_unique<LimitingPreambleThrottler>(PreambleBuildLimit);
+    Opts.PreambleThrottler = Throttler.get();
+  }
   Opts.MemoryCleanup = getMemoryCleanupFunction();
 
   Opts.CodeComplete.IncludeIneligibleResults = IncludeIneligibleResults;
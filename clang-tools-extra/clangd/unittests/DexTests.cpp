@@ -22,6 +22,7 @@
 
 using ::testing::AnyOf;
 using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
 using ::testing::IsEmpty;
 using ::testing::UnorderedElementsAre;
 
@@ -65,6 +66,29 @@ TEST(DexIterators, DocumentIterator) {
   EXPECT_TRUE(DocIterator->reachedEnd());
 }
 
+TEST(DexIterators, DocumentIteratorManyChunks) {
+  // Mix one-byte and multi-byte deltas so that the list spans many chunks.
+  std::vector<DocID> Docs;
+  for (DocID I = 0; Docs.size() < 2000; I += (I % 7 == 0) ? 300 : 3)
+    Docs.push_back(I);
+  const PostingList L(Docs);
+
+  auto DocIterator = L.iterator();
+  EXPECT_THAT(consumeIDs(*DocIterator), ElementsAreArray(Docs));
+
+  DocIterator = L.iterator();
+  for (size_t I = 0; I < Docs.size(); I += 37) {
+    DocIterator->advanceTo(Docs[I]);
+    ASSERT_FALSE(DocIterator->reachedEnd());
+    EXPECT_EQ(DocIterator->peek(), Docs[I]);
+    DocIterator->advanceTo(Docs[I] + 1);
+    ASSERT_FALSE(DocIterator->reachedEnd());
+    EXPECT_EQ(DocIterator->peek(), Docs[I + 1]);
+  }
+  DocIterator->advanceTo(Docs.back() + 1);
+  EXPECT_TRUE(DocIterator->reachedEnd());
+}
+
 TEST(DexIterators, AndTwoLists) {
   Corpus C{10000};
   const PostingList L0({0, 5, 7, 10, 42, 320, 9000});
@@ -1652,6 +1652,81 @@ TEST_F(TUSchedulerTests, PreambleThrottle) {
   EXPECT_THAT(Throttler.Releases, UnorderedElementsAre(1, 0));
 }
 
+// Preambles waiting for the throttler are granted from other preamble threads,
+// concurrently with new requests being queued. This must not lose wakeups.
+TEST_F(TUSchedulerTests, LimitingPreambleThrottler) {
+  LimitingPreambleThrottler Throttler(/*MaxConcurrent=*/1);
+
+  struct CaptureBuiltFilenames : public ParsingCallbacks {
+    std::vector<std::string> &Filenames;
+    CaptureBuiltFilenames(std::vector<std::string> &Filenames)
+        : Filenames(Filenames) {}
+    void onPreambleAST(
+        PathRef Path, llvm::StringRef Version, CapturedASTCtx,
+        std::shared_ptr<const include_cleaner::PragmaIncludes> PI) override {
+      // Deliberately no synchronization, only one preamble is built at a time.
+      Filenames.emplace_back(Path);
+    }
+  };
+
+  const int NumFiles = 8;
+  auto Opts = optsForTest();
+  Opts.AsyncThreadsCount = 2 * NumFiles; // throttler is the bottleneck
+  Opts.PreambleThrottler = &Throttler;
+
+  std::vector<std::string> Filenames;
+  std::vector<std::string> BuiltFilenames;
+  {
+    TUScheduler S(CDB, Opts,
+                  std::make_unique<CaptureBuiltFilenames>(BuiltFilenames));
+    for (unsigned I = 0; I < NumFiles; ++I) {
+      auto Path = testPath(std::to_string(I) + ".cc");
+      Filenames.push_back(Path);
+      S.update(Path, getInputs(Path, ""), WantDiagnostics::Yes);
+    }
+    ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+    EXPECT_THAT(BuiltFilenames,
+                testing::UnorderedElementsAreArray(Filenames));
+  }
+}
+
+TEST(LimitingPreambleThrottlerTest, GrantsMostRecentFirst) {
+  LimitingPreambleThrottler Throttler(/*MaxConcurrent=*/2);
+  std::vector<std::string> Granted;
+  auto Acquire = [&](llvm::StringRef Name) {
+    return Throttler.acquire(Name, [&Granted, Name = Name.str()] {
+      Granted.push_back(Name);
+    });
+  };
+
+  auto A = Acquire("a");
+  auto B = Acquire("b");
+  auto C = Acquire("c");
+  auto D = Acquire("d");
+  auto E = Acquire("e");
+  // Only two builds may run at once.
+  EXPECT_THAT(Granted, ElementsAre("a", "b"));
+
+  // A stale request that is still waiting is simply dropped.
+  Throttler.release(D);
+  EXPECT_THAT(Granted, ElementsAre("a", "b"));
+
+  // Finished builds hand their slot to the most recent waiting request.
+  Throttler.release(A);
+  EXPECT_THAT(Granted, ElementsAre("a", "b", "e"));
+  Throttler.release(B);
+  EXPECT_THAT(Granted, ElementsAre("a", "b", "e", "c"));
+  Throttler.release(E);
+  Throttler.release(C);
+
+  // All slots are free again.
+  auto F = Acquire("f");
+  auto G = Acquire("g");
+  EXPECT_THAT(Granted, ElementsAre("a", "b", "e", "c", "f", "g"));
+  Throttler.release(F);
+  Throttler.release(G);
+}
+
 } // namespace
 } // namespace clangd
 } // namespace clang
@@ -214,16 +214,35 @@ private:
                                                      StringRef IndexName,
                                                      bool DisplayCTUProgress);
   template <typename T>
-  const T *findDefInDeclContext(const DeclContext *DC,
-                                StringRef LookupName);
-  template <typename T>
   llvm::Expected<const T *> importDefinitionImpl(const T *D, ASTUnit *Unit);
 
+  /// The function and variable definitions of a loaded AST, keyed by their
+  /// lookup name. It is built on the first lookup into the AST, so further
+  /// lookups do not have to walk the whole translation unit again.
+  struct DefinitionTable {
+    llvm::StringMap<const FunctionDecl *> Functions;
+    llvm::StringMap<const VarDecl *> Vars;
+
+    const FunctionDecl *lookup(StringRef LookupName,
+                               const FunctionDecl *) const {
+      return Functions.lookup(LookupName);
+    }
+    const VarDecl *lookup(StringRef LookupName, const VarDecl *) const {
+      return Vars.lookup(LookupName);
+    }
+  };
+  const DefinitionTable &getDefinitionTable(ASTUnit *Unit);
+
   using ImporterMapTy =
       llvm::DenseMap<TranslationUnitDecl *, std::unique_ptr<ASTImporter>>;
 
   ImporterMapTy ASTUnitImporterMap;
 
+  using DefinitionTableMapTy =
+      llvm::DenseMap<TranslationUnitDecl *, std::unique_ptr<DefinitionTable>>;
+
+  DefinitionTableMapTy DefinitionTables;
+
   ASTContext &Context;
   std::shared_ptr<ASTImporterSharedState> ImporterSharedSt;
 
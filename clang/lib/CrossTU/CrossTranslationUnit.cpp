@@ -250,29 +250,42 @@ CrossTranslationUnitContext::getLookupName(const NamedDecl *ND) {
   return std::string(DeclUSR);
 }
 
-/// Recursively visits the decls of a DeclContext, and returns one with the
-/// given USR.
 template <typename T>
-const T *
-CrossTranslationUnitContext::findDefInDeclContext(const DeclContext *DC,
-                                                  StringRef LookupName) {
+static void addDefinition(const T *D, llvm::StringMap<const T *> &Defs) {
+  const T *ResultDecl;
+  if (!hasBodyOrInit(D, ResultDecl))
+    return;
+  std::optional<std::string> LookupName =
+      CrossTranslationUnitContext::getLookupName(ResultDecl);
+  if (LookupName)
+    Defs.try_emplace(*LookupName, ResultDecl);
+}
+
+/// Recursively visits the decls of a DeclContext, and records the definitions
+/// by their USR. The first definition found in a depth-first walk wins.
+template <typename TableTy>
+static void collectDefinitions(const DeclContext *DC, TableTy &Table) {
   assert(DC && "Declaration Context must not be null");
   for (const Decl *D : DC->decls()) {
-    const auto *SubDC = dyn_cast<DeclContext>(D);
-    if (SubDC)
-      if (const auto *ND = findDefInDeclContext<T>(SubDC, LookupName))
-        return ND;
-
-    const auto *ND = dyn_cast<T>(D);
-    const T *ResultDecl;
-    if (!ND || !hasBodyOrInit(ND, ResultDecl))
-      continue;
-    std::optional<std::string> ResultLookupName = getLookupName(ResultDecl);
-    if (!ResultLookupName || *ResultLookupName != LookupName)
-      continue;
-    return ResultDecl;
+    if (const auto *SubDC = dyn_cast<DeclContext>(D))
+      collectDefinitions(SubDC, Table);
+
+    if (const auto *FD = dyn_cast<FunctionDecl>(D))
+      addDefinition(FD, Table.Functions);
+    else if (const auto *VD = dyn_cast<VarDecl>(D))
+      addDefinition(VD, Table.Vars);
+  }
+}
+
+const CrossTranslationUnitContext::DefinitionTable &
+CrossTranslationUnitContext::getDefinitionTable(ASTUnit *Unit) {
+  TranslationUnitDecl *TU = Unit->getASTContext().getTranslationUnitDecl();
+  std::unique_ptr<DefinitionTable> &Table = DefinitionTables[TU];
+  if (!Table) {
+    Table = std::make_unique<DefinitionTable>();
+    collectDefinitions(TU, *Table);
   }
-  return nullptr;
+  return *Table;
 }
 
 template <typename T>
@@ -343,8 +356,8 @@ llvm::Expected<const T *> CrossTranslationUnitContext::getCrossTUDefinitionImpl(
         index_error_code::lang_dialect_mismatch);
   }
 
-  TranslationUnitDecl *TU = Unit->getASTContext().getTranslationUnitDecl();
-  if (const T *ResultDecl = findDefInDeclContext<T>(TU, *LookupName))
+  if (const T *ResultDecl =
+          getDefinitionTable(Unit).lookup(*LookupName, D))
     return importDefinition(ResultDecl, Unit);
   return llvm::make_error<IndexError>(index_error_code::failed_import);
 }
@@ -24,8 +24,14 @@
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSwitch.h"
+#include "llvm/ADT/bit.h"
+#include <cstring>
 #include <optional>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace clang;
 using namespace clang::dependency_directives_scan;
 using namespace llvm;
@@ -327,6 +333,27 @@ static bool wasLineContinuation(const char *First, unsigned EOLLen) {
   return *(First - (int)EOLLen - 1) == '\\';
 }
 
+/// \returns the first vertical whitespace character in [First, End), or End.
+static const char *findVerticalWhitespace(const char *First,
+                                          const char *const End) {
+#ifdef __SSE2__
+  // Check 16 characters at a time for '\n' or '\r'.
+  const __m128i LFs = _mm_set1_epi8('\n');
+  const __m128i CRs = _mm_set1_epi8('\r');
+  while (End - First >= 16) {
+    __m128i Cv = _mm_loadu_si128((const __m128i *)First);
+    int Mask = _mm_movemask_epi8(
+        _mm_or_si128(_mm_cmpeq_epi8(Cv, LFs), _mm_cmpeq_epi8(Cv, CRs)));
+    if (Mask != 0)
+      return First + llvm::countr_zero<unsigned>(Mask);
+    First += 16;
+  }
+#endif
+  while (First != End && !isVerticalWhitespace(*First))
+    ++First;
+  return First;
+}
+
 static void skipToNewlineRaw(const char *&First, const char *const End) {
   for (;;) {
     if (First == End)
@@ -336,11 +363,10 @@ static void skipToNewlineRaw(const char *&First, const char *const End) {
     if (Len)
       return;
 
-    do {
-      if (++First == End)
-        return;
-      Len = isEOL(First, End);
-    } while (!Len);
+    First = findVerticalWhitespace(First + 1, End);
+    if (First == End)
+      return;
+    Len = isEOL(First, End);
 
     if (First[-1] != '\\')
       return;
@@ -362,11 +388,15 @@ static void skipBlockComment(const char *&First, const char *const End) {
     First = End;
     return;
   }
-  for (First += 3; First != End; ++First)
-    if (First[-1] == '*' && First[0] == '/') {
-      ++First;
+  // Look for each '/' with memchr and check whether it ends the comment.
+  First += 3;
+  while (const char *Slash =
+             static_cast<const char *>(memchr(First, '/', End - First))) {
+    First = Slash + 1;
+    if (Slash[-1] == '*')
       return;
-    }
+  }
+  First = End;
 }
 
 /// \returns True if the current single quotation mark character is a C++14
@@ -50,6 +50,10 @@
 #include <nmmintrin.h>
 #endif
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace clang;
 
 //===----------------------------------------------------------------------===//
@@ -2612,6 +2616,32 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
 
   char C;
   while (true) {
+#ifdef __SSE2__
+    // Skip 16 characters at a time while none of them is a non-ASCII, null or
+    // newline character. Comparison results and non-ASCII characters both have
+    // the high bit set, so a single mask covers all of them.
+    {
+      const __m128i Zeros = _mm_setzero_si128();
+      const __m128i LFs = _mm_set1_epi8('\n');
+      const __m128i CRs = _mm_set1_epi8('\r');
+      const char *Start = CurPtr;
+      while (BufferEnd - CurPtr >= 16) {
+        __m128i Cv = _mm_loadu_si128((const __m128i *)CurPtr);
+        __m128i Special = _mm_or_si128(
+            _mm_or_si128(Cv, _mm_cmpeq_epi8(Cv, Zeros)),
+            _mm_or_si128(_mm_cmpeq_epi8(Cv, LFs), _mm_cmpeq_epi8(Cv, CRs)));
+        int Mask = _mm_movemask_epi8(Special);
+        if (Mask != 0) {
+          CurPtr += llvm::countr_zero<unsigned>(Mask);
+          break;
+        }
+        CurPtr += 16;
+      }
+      if (CurPtr != Start)
+        UnicodeDecodingAlreadyDiagnosed = false;
+    }
+#endif
+
     C = *CurPtr;
     // Skip over characters in the fast loop.
     while (isASCII(C) && C != 0 &&   // Potentially EOF.
@@ -2850,9 +2880,7 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr, Lexer *L,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
+#if !defined(__SSE2__) && __ALTIVEC__
 #include <altivec.h>
 #undef bool
 #endif
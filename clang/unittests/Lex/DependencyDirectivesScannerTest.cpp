@@ -812,6 +812,39 @@ TEST(MinimizeSourceToDependencyDirectivesTest, PoundWarningAndError) {
   }
 }
 
+TEST(MinimizeSourceToDependencyDirectivesTest, LongCommentsAndDiagnostics) {
+  SmallVector<char, 128> Out;
+
+  // Exercise the paths that scan multiple characters at a time, including
+  // terminators at every position of a 16-byte block.
+  for (auto Source : {
+           "#warning a message that is longer than a single block\n"
+           "#include <t.h>\n",
+           "#error a message that is longer than a single block\r"
+           "#include <t.h>\r",
+           "#error a message that is longer than \\\r\n"
+           "a single block and continues\r\n#include <t.h>\n",
+           "/* a block comment that is longer than a single block */\n"
+           "#include <t.h>\n",
+           "/* a block comment with / slashes / and * stars * inside it **/\n"
+           "#include <t.h>\n",
+       }) {
+    ASSERT_FALSE(minimizeSourceToDependencyDirectives(Source, Out));
+    EXPECT_STREQ("#include <t.h>\n", Out.data());
+  }
+
+  for (unsigned Length = 0; Length != 40; ++Length) {
+    std::string Source =
+        "#error " + std::string(Length, 'x') + "\n#include <t.h>\n";
+    ASSERT_FALSE(minimizeSourceToDependencyDirectives(Source, Out));
+    EXPECT_STREQ("#include <t.h>\n", Out.data());
+
+    Source = "/*" + std::string(Length, '*') + "*/\n#include <t.h>\n";
+    ASSERT_FALSE(minimizeSourceToDependencyDirectives(Source, Out));
+    EXPECT_STREQ("#include <t.h>\n", Out.data());
+  }
+}
+
 TEST(MinimizeSourceToDependencyDirectivesTest, CharacterLiteral) {
   SmallVector<char, 128> Out;
 
@@ -708,6 +708,54 @@ TEST_F(LexerTest, RawAndNormalLexSameForLineComments) {
   EXPECT_TRUE(ToksView.empty());
 }
 
+TEST_F(LexerTest, LongLineComments) {
+  // Line comments longer than 16 bytes are skipped a block at a time. The
+  // block loop has to stop at non-ASCII bytes, escaped newlines and the end of
+  // the buffer.
+  const llvm::StringLiteral Source =
+      "int a; // a comment longer than 16 bytes with \xc3\xa9 in it\n"
+      "int b; // invalid UTF-8 \xff after more than sixteen bytes\n"
+      "int c; // a comment continued on the next line \\\n"
+      "int hidden; and more text that is still in the comment\n"
+      "int d; // a continuation with a CRLF line ending \\\r\n"
+      "int hidden2;\r\n"
+      "int e; // a comment ending at the end of the buffer";
+  std::vector<Token> Toks = CheckLex(
+      Source, {tok::kw_int, tok::identifier, tok::semi, tok::kw_int,
+               tok::identifier, tok::semi, tok::kw_int, tok::identifier,
+               tok::semi, tok::kw_int, tok::identifier, tok::semi,
+               tok::kw_int, tok::identifier, tok::semi});
+  ASSERT_EQ(Toks.size(), 15U);
+  std::vector<std::string> Names;
+  for (unsigned I = 1; I < Toks.size(); I += 3)
+    Names.push_back(getSourceText(Toks[I], Toks[I]));
+  EXPECT_THAT(Names, ElementsAre("a", "b", "c", "d", "e"));
+
+  auto &SM = PP->getSourceManager();
+  auto SrcBuffer = SM.getBufferData(SM.getMainFileID());
+  Lexer L(SM.getLocForStartOfFile(SM.getMainFileID()), PP->getLangOpts(),
+          SrcBuffer.data(), SrcBuffer.data(),
+          SrcBuffer.data() + SrcBuffer.size());
+  L.SetCommentRetentionState(true);
+  std::vector<std::string> Comments;
+  Token T;
+  do {
+    L.LexFromRawLexer(T);
+    if (T.is(tok::comment))
+      Comments.emplace_back(SM.getCharacterData(T.getLocation()),
+                            T.getLength());
+  } while (T.isNot(tok::eof));
+  EXPECT_THAT(
+      Comments,
+      ElementsAre("// a comment longer than 16 bytes with \xc3\xa9 in it",
+                  "// invalid UTF-8 \xff after more than sixteen bytes",
+                  "// a comment continued on the next line \\\n"
+                  "int hidden; and more text that is still in the comment",
+                  "// a continuation with a CRLF line ending \\\r\n"
+                  "int hidden2;",
+                  "// a comment ending at the end of the buffer"));
+}
+
 TEST_F(LexerTest, GetRawTokenOnEscapedNewLineChecksWhitespace) {
   const llvm::StringLiteral Source = R"cc(
   #define ONE \
@@ -27,6 +27,14 @@
 void operator delete(void *, size_t) noexcept;
 void operator delete[](void *, size_t) noexcept;
 
+// Hot/cold hint variants of operator new, as emitted by LLVM for allocations
+// annotated by memory profiling.
+enum class __hot_cold_t : uint8_t {};
+void *operator new(size_t, __hot_cold_t);
+void *operator new[](size_t, __hot_cold_t);
+void *operator new(size_t, const std::nothrow_t &, __hot_cold_t) noexcept;
+void *operator new(size_t, std::align_val_t, __hot_cold_t);
+
 extern "C" {
 #ifndef SCUDO_ENABLE_HOOKS_TESTS
 #define SCUDO_ENABLE_HOOKS_TESTS 0
@@ -158,6 +166,38 @@ TEST_F(ScudoWrappersCppDeathTest, New) {
   testCxxNew<Pixel>();
 }
 
+TEST_F(ScudoWrappersCppTest, HotColdNew) {
+  const size_t Size = 32U;
+  for (uint8_t Hint : {0, 128, 255}) {
+    const __hot_cold_t HotCold = static_cast<__hot_cold_t>(Hint);
+
+    void *P = operator new(Size, HotCold);
+    EXPECT_NE(P, nullptr);
+    verifyAllocHookPtr(P);
+    verifyAllocHookSize(Size);
+    memset(P, 0x42, Size);
+    operator delete(P);
+    verifyDeallocHookPtr(P);
+
+    P = operator new[](Size, HotCold);
+    EXPECT_NE(P, nullptr);
+    memset(P, 0x42, Size);
+    operator delete[](P);
+
+    P = operator new(Size, std::nothrow, HotCold);
+    EXPECT_NE(P, nullptr);
+    memset(P, 0x42, Size);
+    operator delete(P);
+
+    const std::align_val_t Align = static_cast<std::align_val_t>(64U);
+    P = operator new(Size, Align, HotCold);
+    EXPECT_NE(P, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(P) % 64U, 0U);
+    memset(P, 0x42, Size);
+    operator delete(P, Align);
+  }
+}
+
 static std::mutex Mutex;
 static std::condition_variable Cv;
 static bool Ready;
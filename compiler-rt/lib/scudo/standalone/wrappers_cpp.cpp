@@ -24,6 +24,13 @@ struct nothrow_t {};
 enum class align_val_t : size_t {};
 } // namespace std
 
+// Hint passed by the hot/cold operator new variants that LLVM emits for
+// allocations annotated by memory profiling (-optimize-hot-cold-new). 0 is the
+// coldest and 255 the hottest. Scudo does not segregate allocations by
+// hotness, so the hint is accepted and ignored, which lets such binaries use
+// Scudo as their allocator.
+enum class __hot_cold_t : uint8_t {};
+
 static void reportAllocation(void *ptr, size_t size) {
   if (SCUDO_ENABLE_HOOKS)
     if (__scudo_allocate_hook && ptr)
@@ -84,6 +91,59 @@ INTERFACE WEAK void *operator new[](size_t size, std::align_val_t align,
   return Ptr;
 }
 
+INTERFACE WEAK void *operator new(size_t size, __hot_cold_t) {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::New);
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new[](size_t size, __hot_cold_t) {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::NewArray);
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new(size_t size, std::nothrow_t const &,
+                                  __hot_cold_t) NOEXCEPT {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::New);
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new[](size_t size, std::nothrow_t const &,
+                                    __hot_cold_t) NOEXCEPT {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::NewArray);
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new(size_t size, std::align_val_t align,
+                                  __hot_cold_t) {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::New,
+                                 static_cast<scudo::uptr>(align));
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new[](size_t size, std::align_val_t align,
+                                    __hot_cold_t) {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::NewArray,
+                                 static_cast<scudo::uptr>(align));
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new(size_t size, std::align_val_t align,
+                                  std::nothrow_t const &,
+                                  __hot_cold_t) NOEXCEPT {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::New,
+                                 static_cast<scudo::uptr>(align));
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new[](size_t size, std::align_val_t align,
+                                    std::nothrow_t const &,
+                                    __hot_cold_t) NOEXCEPT {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::NewArray,
+                                 static_cast<scudo::uptr>(align));
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+
 INTERFACE WEAK void operator delete(void *ptr) NOEXCEPT {
   reportDeallocation(ptr);
   Allocator.deallocate(ptr, scudo::Chunk::Origin::New);
@@ -1138,11 +1138,32 @@ void TypeMerger::mergeTypesWithGHash() {
   // - item records
   //   - source 0, type 1...
   //   - source 1, type 0...
-  std::vector<GHashCell> entries;
-  for (const GHashCell &cell : ArrayRef(ghashState.table.table, tableSize)) {
-    if (!cell.isEmpty())
-      entries.push_back(cell);
-  }
+  //
+  // The table is as large as the total number of input type records, so scan
+  // it in parallel. Count the non-empty cells of each chunk first so that
+  // every chunk knows where to store its cells. The order of the collected
+  // cells does not matter because they are sorted afterwards.
+  ArrayRef<GHashCell> cells(ghashState.table.table, tableSize);
+  const size_t chunkSize = 1 << 16;
+  const size_t numChunks = divideCeil(tableSize, chunkSize);
+  auto getChunk = [&](size_t i) {
+    return cells.slice(i * chunkSize,
+                       std::min(chunkSize, tableSize - i * chunkSize));
+  };
+  std::vector<size_t> chunkOffsets(numChunks + 1);
+  parallelFor(0, numChunks, [&](size_t i) {
+    chunkOffsets[i + 1] = llvm::count_if(
+        getChunk(i), [](const GHashCell &cell) { return !cell.isEmpty(); });
+  });
+  for (size_t i = 0; i < numChunks; ++i)
+    chunkOffsets[i + 1] += chunkOffsets[i];
+  std::vector<GHashCell> entries(chunkOffsets[numChunks]);
+  parallelFor(0, numChunks, [&](size_t i) {
+    size_t pos = chunkOffsets[i];
+    for (const GHashCell &cell : getChunk(i))
+      if (!cell.isEmpty())
+        entries[pos++] = cell;
+  });
   parallelSort(entries, std::less<GHashCell>());
   Log(ctx) << formatv(
       "ghash table load factor: {0:p} (size {1} / capacity {2})\n",
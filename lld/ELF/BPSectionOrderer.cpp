@@ -64,8 +64,8 @@ struct BPOrdererELF : lld::BPOrderer<BPOrdererELF> {
 
 DenseMap<const InputSectionBase *, int> elf::runBalancedPartitioning(
     Ctx &ctx, StringRef profilePath, bool forFunctionCompression,
-    bool forDataCompression, bool compressionSortStartupFunctions,
-    bool verbose) {
+    bool forDataCompression, bool compressionSortStartupFunctions, bool verbose,
+    const DenseMap<const InputSectionBase *, int> &excluded) {
   // Collect candidate sections and associated symbols.
   SmallVector<InputSectionBase *> sections;
   DenseMap<CachedHashStringRef, std::set<unsigned>> rootSymbolToSectionIdxs;
@@ -79,7 +79,7 @@ DenseMap<const InputSectionBase *, int> elf::runBalancedPartitioning(
     // Skip empty, discarded, ICF folded sections. Skipping ICF folded sections
     // reduces duplicate detection work in BPSectionOrderer.
     if (!sec || sec->size == 0 || !sec->isLive() || sec->repl != sec ||
-        !orderer.secToSym.try_emplace(sec, d).second)
+        excluded.count(sec) || !orderer.secToSym.try_emplace(sec, d).second)
       return;
     rootSymbolToSectionIdxs[CachedHashStringRef(getRootSymbol(sym.getName()))]
         .insert(sections.size());
@@ -27,10 +27,13 @@ class InputSectionBase;
 /// It is important that -ffunction-sections and -fdata-sections compiler flags
 /// are used to ensure functions and data are in their own sections and thus
 /// can be reordered.
-llvm::DenseMap<const InputSectionBase *, int>
-runBalancedPartitioning(Ctx &ctx, llvm::StringRef profilePath,
-                        bool forFunctionCompression, bool forDataCompression,
-                        bool compressionSortStartupFunctions, bool verbose);
+///
+/// Sections in \p excluded, which have already been ordered by another
+/// orderer, are not considered.
+llvm::DenseMap<const InputSectionBase *, int> runBalancedPartitioning(
+    Ctx &ctx, llvm::StringRef profilePath, bool forFunctionCompression,
+    bool forDataCompression, bool compressionSortStartupFunctions, bool verbose,
+    const llvm::DenseMap<const InputSectionBase *, int> &excluded = {});
 
 } // namespace lld::elf
 
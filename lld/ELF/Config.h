@@ -275,6 +275,10 @@ struct Config {
   bool bpCompressionSortStartupFunctions = false;
   bool bpFunctionOrderForCompression = false;
   bool bpDataOrderForCompression = false;
+  // --bp-compression-sort with --call-graph-ordering-file or
+  // --call-graph-profile-sort: sections in the call graph profile are ordered
+  // by it, the rest by balanced partitioning.
+  bool bpWithCallGraphProfile = false;
   bool bpVerboseSectionOrderer = false;
   bool checkSections;
   bool checkDynamicRelocs;
@@ -325,6 +329,7 @@ struct Config {
   bool optEL = false;
   bool optimizeBBJumps;
   bool optRemarksWithHotness;
+  bool parallelGcSections;
   bool picThunk;
   bool pie;
   bool printGcSections;
@@ -1156,9 +1156,16 @@ static void parseBPOrdererOptions(Ctx &ctx, opt::InputArgList &args) {
       ErrAlways(ctx) << arg->getSpelling()
                      << ": expected [none|function|data|both]";
     }
-    if (s != "none" && args.hasArg(OPT_call_graph_ordering_file))
-      ErrAlways(ctx) << "--bp-compression-sort is incompatible with "
-                        "--call-graph-ordering-file";
+    // Hot sections named by the call graph profile are laid out first by call
+    // graph sort; balanced partitioning orders the remaining sections. The
+    // profile is either --call-graph-ordering-file or, if
+    // --call-graph-profile-sort is given explicitly, the
+    // .llvm.call-graph-profile sections of the input files.
+    if (s != "none" &&
+        ctx.arg.callGraphProfileSort != CGProfileSortKind::None &&
+        (args.hasArg(OPT_call_graph_ordering_file) ||
+         args.hasArg(OPT_call_graph_profile_sort)))
+      ctx.arg.bpWithCallGraphProfile = true;
   }
   if (auto *arg = args.getLastArg(OPT_bp_startup_sort)) {
     StringRef s = arg->getValue();
@@ -1171,6 +1178,8 @@ static void parseBPOrdererOptions(Ctx &ctx, opt::InputArgList &args) {
       ErrAlways(ctx) << "--bp-startup-sort=function is incompatible with "
                         "--call-graph-ordering-file";
   }
+  if (ctx.arg.bpStartupFunctionSort)
+    ctx.arg.bpWithCallGraphProfile = false;
 
   ctx.arg.bpCompressionSortStartupFunctions =
       args.hasFlag(OPT_bp_compression_sort_startup_functions,
@@ -1374,6 +1383,8 @@ static void readConfigs(Ctx &ctx, opt::InputArgList &args) {
   ctx.arg.fortranCommon =
       args.hasFlag(OPT_fortran_common, OPT_no_fortran_common, false);
   ctx.arg.gcSections = args.hasFlag(OPT_gc_sections, OPT_no_gc_sections, false);
+  ctx.arg.parallelGcSections = args.hasFlag(
+      OPT_parallel_gc_sections, OPT_no_parallel_gc_sections, false);
   ctx.arg.gnuUnique = args.hasFlag(OPT_gnu_unique, OPT_no_gnu_unique, true);
   ctx.arg.gdbIndex = args.hasFlag(OPT_gdb_index, OPT_no_gdb_index, false);
   ctx.arg.icf = getICF(args);
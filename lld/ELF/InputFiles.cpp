@@ -26,6 +26,7 @@
 #include "llvm/Support/ARMBuildAttributes.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/RISCVAttributeParser.h"
 #include "llvm/Support/TimeProfiler.h"
@@ -349,6 +350,23 @@ template <class ELFT>
 static void
 doParseFiles(Ctx &ctx,
              const SmallVector<std::unique_ptr<InputFile>, 0> &files) {
+  // Hashing symbol names is a large fraction of the cost of symbol resolution
+  // and, unlike resolution itself, does not depend on the order in which files
+  // are processed. Do it in parallel ahead of time so that the serial loop
+  // below only probes the symbol table. Lazy files only insert their defined
+  // symbols and most are never extracted, so they are hashed on the fly
+  // instead. Files of a different ELF kind or machine are rejected by
+  // isCompatible and are skipped as well.
+  {
+    llvm::TimeTraceScope timeScope("Hash symbol names");
+    parallelForEach(files, [&](const std::unique_ptr<InputFile> &file) {
+      if (auto *f = dyn_cast<ObjFile<ELFT>>(file.get()))
+        if (!f->lazy && f->ekind == ctx.arg.ekind &&
+            f->emachine == ctx.arg.emachine)
+          f->computeSymbolNameHashes();
+    });
+  }
+
   // Add all files to the symbol table. This will add almost all symbols that we
   // need to the symbol table. This process might add files to the link due to
   // addDependentLibrary.
@@ -1130,9 +1148,18 @@ void ObjFile<ELFT>::initializeSymbols(const object::ELFFile<ELFT> &obj) {
 
   // Some entries have been filled by LazyObjFile.
   auto *symtab = ctx.symtab.get();
-  for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
-    if (!symbols[i])
-      symbols[i] = symtab->insert(CHECK2(eSyms[i].getName(stringTable), this));
+  if (!nameHashes.empty()) {
+    for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
+      if (!symbols[i])
+        symbols[i] = symtab->insert(CHECK2(eSyms[i].getName(stringTable), this),
+                                    nameHashes[i - firstGlobal]);
+    nameHashes = SmallVector<uint32_t, 0>();
+  } else {
+    for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
+      if (!symbols[i])
+        symbols[i] =
+            symtab->insert(CHECK2(eSyms[i].getName(stringTable), this));
+  }
 
   // Perform symbol resolution on non-local symbols.
   SmallVector<unsigned, 32> undefineds;
@@ -1961,6 +1988,24 @@ template <class ELFT> void ObjFile<ELFT>::parseLazy() {
   }
 }
 
+template <class ELFT> void ObjFile<ELFT>::computeSymbolNameHashes() {
+  ArrayRef<Elf_Sym> eSyms = this->getELFSyms<ELFT>();
+  if (eSyms.size() <= firstGlobal)
+    return;
+  nameHashes.resize_for_overwrite(eSyms.size() - firstGlobal);
+  for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
+    Expected<StringRef> name = eSyms[i].getName(stringTable);
+    if (!name) {
+      // Leave the error to be reported by the serial symbol resolution.
+      consumeError(name.takeError());
+      nameHashes = SmallVector<uint32_t, 0>();
+      return;
+    }
+    nameHashes[i - firstGlobal] =
+        CachedHashStringRef(SymbolTable::getSymbolStem(*name)).hash();
+  }
+}
+
 bool InputFile::shouldExtractForCommon(StringRef name) const {
   if (isa<BitcodeFile>(this))
     return isBitcodeNonCommonDef(mb, name, archiveName);
@@ -294,6 +294,11 @@ public:
   void postParse();
   void importCmseSymbols();
 
+  // Precompute the symbol table hashes of global symbol names. This is safe to
+  // call concurrently for different files and moves the hashing out of the
+  // serial symbol resolution in parse().
+  void computeSymbolNameHashes();
+
 private:
   void initializeSections(bool ignoreComdats,
                           const llvm::object::ELFFile<ELFT> &obj);
@@ -319,6 +324,12 @@ private:
   // The following variable contains the contents of .symtab_shndx.
   // If the section does not exist (which is common), the array is empty.
   ArrayRef<Elf_Word> shndxTable;
+
+  // SymbolTable::getSymbolStem hashes of global symbol names, indexed by
+  // symbol index minus firstGlobal. Filled by computeSymbolNameHashes and
+  // released by initializeSymbols once the symbols have been inserted. Empty
+  // if not computed.
+  SmallVector<uint32_t, 0> nameHashes;
 };
 
 class BitcodeFile : public InputFile {
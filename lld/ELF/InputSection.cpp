@@ -1419,7 +1419,21 @@ uint64_t EhInputSection::getParentOffset(uint64_t offset) const {
   return it[-1].outputOff + (offset - it[-1].inputOff);
 }
 
+// Returns the offset of the first all-zero entry. Entries of 2 and 4 bytes
+// (UTF-16 and UTF-32 strings) are compared with a single load each rather than
+// checking every byte of the entry.
+template <class T> static size_t findNullWord(StringRef s) {
+  for (size_t i = 0, n = s.size(); i != n; i += sizeof(T))
+    if (endian::read<T, llvm::endianness::native>(s.data() + i) == 0)
+      return i;
+  llvm_unreachable("");
+}
+
 static size_t findNull(StringRef s, size_t entSize) {
+  if (entSize == 2)
+    return findNullWord<uint16_t>(s);
+  if (entSize == 4)
+    return findNullWord<uint32_t>(s);
   for (unsigned i = 0, n = s.size(); i != n; i += entSize) {
     const char *b = s.begin() + i;
     if (std::all_of(b, b + entSize, [](char c) { return c == 0; }))
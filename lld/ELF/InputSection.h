@@ -20,6 +20,7 @@
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/Object/ELF.h"
 #include "llvm/Support/Compiler.h"
+#include <atomic>
 
 namespace lld {
 namespace elf {
@@ -53,6 +54,31 @@ template <class ELFT> struct RelsOrRelas {
       f(__VA_ARGS__, rs.relas);                                                \
   }
 
+// The partition of a section. It is atomic so that the parallel mark phase of
+// --gc-sections can claim sections from several threads. Relaxed loads and
+// stores compile to plain moves, so other users pay nothing for this.
+class SectionPartition {
+public:
+  constexpr SectionPartition(uint8_t v) : v(v) {}
+  SectionPartition(const SectionPartition &other) : v(uint8_t(other)) {}
+  SectionPartition &operator=(const SectionPartition &other) {
+    return *this = uint8_t(other);
+  }
+  SectionPartition &operator=(uint8_t x) {
+    v.store(x, std::memory_order_relaxed);
+    return *this;
+  }
+  operator uint8_t() const { return v.load(std::memory_order_relaxed); }
+
+  // Sets the partition to x and returns the previous value.
+  uint8_t exchange(uint8_t x) {
+    return v.exchange(x, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<uint8_t> v;
+};
+
 // This is the base class of all sections that lld handles. Some are sections in
 // input files, some are sections in the produced output file and some exist
 // just as a convenience for implementing special ways of combining some
@@ -92,7 +118,7 @@ public:
   uint32_t entsize;
 
   Kind sectionKind;
-  uint8_t partition = 1;
+  SectionPartition partition = 1;
 
   // The next two bit fields are only used by InputSectionBase, but we
   // put them here so the struct packs better.
@@ -32,6 +32,7 @@
 #include "llvm/ADT/DenseMapInfoVariant.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Object/ELF.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/TimeProfiler.h"
 #include <variant>
 #include <vector>
@@ -68,6 +69,8 @@ private:
                LiveReason reason);
   void markSymbol(Symbol *sym, StringRef reason);
   void mark();
+  void markParallel();
+  void visit(InputSectionBase &sec);
 
   template <class RelTy>
   void resolveReloc(InputSectionBase &sec, RelTy &rel, bool fromFDE);
@@ -82,6 +85,21 @@ private:
   // A list of sections to visit.
   SmallVector<InputSection *, 0> queue;
 
+  // State of a thread in markParallel. Sections are claimed by atomically
+  // setting their partition. Symbol::used and SectionPiece::live are bitfields
+  // and SharedFile::isNeeded is not atomic, so updates to them are recorded
+  // here and applied once all threads are done.
+  struct ThreadState {
+    // Sections to visit.
+    SmallVector<InputSection *, 0> queue;
+    SmallVector<Symbol *, 0> used;
+    SmallVector<SharedFile *, 0> needed;
+    SmallVector<SectionPiece *, 0> pieces;
+  };
+  // Indexed by parallel::getThreadIndex. Only used by markParallel; enqueue
+  // and resolveReloc use it when it is non-empty.
+  SmallVector<ThreadState, 0> threadStates;
+
   // There are normally few input sections whose names are valid C
   // identifiers, so we just store a SmallVector instead of a multimap.
   DenseMap<StringRef, SmallVector<InputSectionBase *, 0>> cNamedSections;
@@ -120,7 +138,12 @@ void MarkLive<ELFT, TrackWhyLive>::resolveReloc(InputSectionBase &sec,
                                                 RelTy &rel, bool fromFDE) {
   // If a symbol is referenced in a live section, it is used.
   Symbol &sym = sec.file->getRelocTargetSym(rel);
-  sym.used = true;
+  if (!TrackWhyLive && !threadStates.empty()) {
+    if (!sym.used)
+      threadStates[parallel::getThreadIndex()].used.push_back(&sym);
+  } else {
+    sym.used = true;
+  }
 
   LiveReason reason;
   if (TrackWhyLive)
@@ -163,7 +186,13 @@ void MarkLive<ELFT, TrackWhyLive>::resolveReloc(InputSectionBase &sec,
 
   if (auto *ss = dyn_cast<SharedSymbol>(&sym)) {
     if (!ss->isWeak()) {
-      cast<SharedFile>(ss->file)->isNeeded = true;
+      auto *file = cast<SharedFile>(ss->file);
+      if (!TrackWhyLive && !threadStates.empty()) {
+        if (!file->isNeeded)
+          threadStates[parallel::getThreadIndex()].needed.push_back(file);
+      } else {
+        file->isNeeded = true;
+      }
       if (TrackWhyLive)
         whyLive.try_emplace(&sym, reason);
     }
@@ -234,8 +263,24 @@ void MarkLive<ELFT, TrackWhyLive>::enqueue(InputSectionBase *sec,
   // Usually, a whole section is marked as live or dead, but in mergeable
   // (splittable) sections, each piece of data has independent liveness bit.
   // So we explicitly tell it which offset is in use.
-  if (auto *ms = dyn_cast<MergeInputSection>(sec))
-    ms->getSectionPiece(offset).live = true;
+  if (auto *ms = dyn_cast<MergeInputSection>(sec)) {
+    SectionPiece &piece = ms->getSectionPiece(offset);
+    if (threadStates.empty())
+      piece.live = true;
+    else if (!piece.live)
+      threadStates[parallel::getThreadIndex()].pieces.push_back(&piece);
+  }
+
+  if (!TrackWhyLive && !threadStates.empty()) {
+    // markParallel is only used with a single partition, where a section is
+    // either dead (0) or live (1). The thread that makes a section live visits
+    // it, so every live section is visited exactly once.
+    if (sec->partition == 1 || sec->partition.exchange(1) == 1)
+      return;
+    if (InputSection *s = dyn_cast<InputSection>(sec))
+      threadStates[parallel::getThreadIndex()].queue.push_back(s);
+    return;
+  }
 
   // Set Sec->Partition to the meet (i.e. the "minimum") of Partition and
   // Sec->Partition in the following lattice: 1 < other < 0. If Sec->Partition
@@ -444,29 +489,94 @@ void MarkLive<ELFT, TrackWhyLive>::run() {
   }
 }
 
+template <class ELFT, bool TrackWhyLive>
+void MarkLive<ELFT, TrackWhyLive>::visit(InputSectionBase &sec) {
+  const RelsOrRelas<ELFT> rels = sec.template relsOrRelas<ELFT>();
+  for (const typename ELFT::Rel &rel : rels.rels)
+    resolveReloc(sec, rel, false);
+  for (const typename ELFT::Rela &rel : rels.relas)
+    resolveReloc(sec, rel, false);
+  for (const typename ELFT::Crel &rel : rels.crels)
+    resolveReloc(sec, rel, false);
+
+  for (InputSectionBase *isec : sec.dependentSections)
+    enqueue(isec, /*offset=*/0, /*sym=*/nullptr,
+            {&sec, "depended on by section"});
+
+  // Mark the next group member.
+  if (sec.nextInSectionGroup)
+    enqueue(sec.nextInSectionGroup, /*offset=*/0, /*sym=*/nullptr,
+            {&sec, "in section group with"});
+}
+
 template <class ELFT, bool TrackWhyLive>
 void MarkLive<ELFT, TrackWhyLive>::mark() {
+  // With --parallel-gc-sections, the liveness graph is traversed in parallel
+  // when there is only one partition and no --why-live reasons need to be
+  // recorded. In both cases the set of live sections is the same.
+  if (!TrackWhyLive && ctx.arg.parallelGcSections &&
+      ctx.partitions.size() == 1 && ctx.arg.threadCount > 1 && !queue.empty()) {
+    markParallel();
+    return;
+  }
+
   // Mark all reachable sections.
-  while (!queue.empty()) {
-    InputSectionBase &sec = *queue.pop_back_val();
-
-    const RelsOrRelas<ELFT> rels = sec.template relsOrRelas<ELFT>();
-    for (const typename ELFT::Rel &rel : rels.rels)
-      resolveReloc(sec, rel, false);
-    for (const typename ELFT::Rela &rel : rels.relas)
-      resolveReloc(sec, rel, false);
-    for (const typename ELFT::Crel &rel : rels.crels)
-      resolveReloc(sec, rel, false);
-
-    for (InputSectionBase *isec : sec.dependentSections)
-      enqueue(isec, /*offset=*/0, /*sym=*/nullptr,
-              {&sec, "depended on by section"});
-
-    // Mark the next group member.
-    if (sec.nextInSectionGroup)
-      enqueue(sec.nextInSectionGroup, /*offset=*/0, /*sym=*/nullptr,
-              {&sec, "in section group with"});
+  while (!queue.empty())
+    visit(*queue.pop_back_val());
+}
+
+// Traverse the liveness graph with one worklist per thread. A task drains the
+// worklist of the thread it runs on and hands half of it to a new task whenever
+// it grows large, so that idle threads pick up work from busy ones.
+template <class ELFT, bool TrackWhyLive>
+void MarkLive<ELFT, TrackWhyLive>::markParallel() {
+  llvm::TimeTraceScope timeScope("Mark live sections in parallel");
+  constexpr size_t splitThreshold = 64;
+  threadStates.resize(ctx.arg.threadCount);
+
+  parallel::TaskGroup tg;
+  std::function<void(SmallVector<InputSection *, 0>)> work =
+      [&](SmallVector<InputSection *, 0> items) {
+        SmallVector<InputSection *, 0> &q =
+            threadStates[parallel::getThreadIndex()].queue;
+        q = std::move(items);
+        while (!q.empty()) {
+          if (q.size() > splitThreshold) {
+            auto mid = q.begin() + q.size() / 2;
+            SmallVector<InputSection *, 0> half(mid, q.end());
+            q.erase(mid, q.end());
+            tg.spawn([&work, half = std::move(half)]() mutable {
+              work(std::move(half));
+            });
+            continue;
+          }
+          visit(*q.pop_back_val());
+        }
+      };
+
+  // Seed one task per chunk of the initial worklist.
+  size_t chunk = std::max<size_t>(splitThreshold / 2,
+                                  queue.size() / ctx.arg.threadCount + 1);
+  for (size_t i = 0, e = queue.size(); i < e; i += chunk) {
+    SmallVector<InputSection *, 0> items(
+        queue.begin() + i, queue.begin() + std::min(e, i + chunk));
+    tg.spawn([&work, items = std::move(items)]() mutable {
+      work(std::move(items));
+    });
+  }
+  tg.sync();
+  queue.clear();
+
+  // Apply the updates recorded by the threads.
+  for (ThreadState &ts : threadStates) {
+    for (Symbol *sym : ts.used)
+      sym->used = true;
+    for (SharedFile *file : ts.needed)
+      file->isNeeded = true;
+    for (SectionPiece *piece : ts.pieces)
+      piece->live = true;
   }
+  threadStates.clear();
 }
 
 // Move the sections for some symbols to the main partition, specifically ifuncs
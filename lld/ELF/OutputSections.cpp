@@ -271,6 +271,7 @@ void OutputSection::finalizeInputSections() {
       }
     }
 
+    llvm::TimeTraceScope timeScope("Merge sections", ms->name);
     ms->finalizeContents();
   }
 }
@@ -493,6 +494,33 @@ static void writeInt(Ctx &ctx, uint8_t *buf, uint64_t data, uint64_t size) {
     llvm_unreachable("unsupported Size argument");
 }
 
+// Returns the estimated cost of writing an input section, in units of bytes
+// copied. Applying a relocation is assumed to cost as much as copying
+// bytesPerReloc bytes.
+template <class ELFT> static size_t getWriteCost(const InputSection &isec) {
+  constexpr size_t bytesPerReloc = 64;
+  size_t numRelocs = isec.relocs().size();
+  // Relocations of non-SHF_ALLOC sections are not scanned into relocs() and
+  // are applied directly from the input file. Get their number from the
+  // relocation section.
+  if (!numRelocs && isec.relSecIdx && !(isec.flags & SHF_ALLOC)) {
+    if (auto *f = dyn_cast_or_null<ObjFile<ELFT>>(isec.file)) {
+      const typename ELFT::Shdr &shdr =
+          f->template getELFShdrs<ELFT>()[isec.relSecIdx];
+      if (shdr.sh_type == SHT_REL)
+        numRelocs = shdr.sh_size / sizeof(typename ELFT::Rel);
+      else if (shdr.sh_type == SHT_RELA)
+        numRelocs = shdr.sh_size / sizeof(typename ELFT::Rela);
+      else if (shdr.sh_type == SHT_CREL)
+        numRelocs = RelocsCrel<ELFT::Is64Bits>(
+                        (const uint8_t *)f->mb.getBufferStart() +
+                        shdr.sh_offset)
+                        .size();
+    }
+  }
+  return isec.getSize() + numRelocs * bytesPerReloc;
+}
+
 template <class ELFT>
 void OutputSection::writeTo(Ctx &ctx, uint8_t *buf, parallel::TaskGroup &tg) {
   llvm::TimeTraceScope timeScope("Write sections", name);
@@ -595,9 +623,15 @@ void OutputSection::writeTo(Ctx &ctx, uint8_t *buf, parallel::TaskGroup &tg) {
   // time with other output sections. Note, if a linker script specifies
   // overlapping output sections (needs --noinhibit-exec or --no-check-sections
   // to supress the error), the output may be non-deterministic.
+  //
+  // Sections are grouped into tasks by the estimated cost of writing them,
+  // which includes applying relocations, not just by size: in relocation dense
+  // sections (e.g. .debug_info) relocation processing dominates the memcpy.
+  // An input section is never split, so a single large section is still
+  // written by one task.
   const size_t taskSizeLimit = 4 << 20;
   for (size_t begin = 0, i = 0, taskSize = 0;;) {
-    taskSize += sections[i]->getSize();
+    taskSize += getWriteCost<ELFT>(*sections[i]);
     bool done = ++i == numSections;
     if (done || taskSize >= taskSizeLimit) {
       tg.spawn([=] { fn(begin, i); });
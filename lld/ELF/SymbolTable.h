@@ -44,6 +44,21 @@ public:
   void wrap(Symbol *sym, Symbol *real, Symbol *wrap);
 
   Symbol *insert(StringRef name);
+  // Same as above, but with the hash of getSymbolStem(name) precomputed, for
+  // callers that hash symbol names in parallel ahead of symbol resolution.
+  Symbol *insert(StringRef name, uint32_t stemHash);
+
+  // Returns the part of a symbol name that is used as the key of the symbol
+  // table: <name>@@<version> is keyed by <name>.
+  static StringRef getSymbolStem(StringRef name) {
+    // Since this is a hot path, the following string search code is
+    // optimized for speed. StringRef::find(char) is much faster than
+    // StringRef::find(StringRef).
+    size_t pos = name.find('@');
+    if (pos != StringRef::npos && pos + 1 < name.size() && name[pos + 1] == '@')
+      return name.take_front(pos);
+    return name;
+  }
 
   template <typename T> Symbol *addSymbol(const T &newSym) {
     Symbol *sym = insert(newSym.getName());
@@ -3134,6 +3134,18 @@ std::pair<uint32_t, uint32_t> DebugNamesBaseSection::computeEntryPool(
     }
   });
 
+  // The name entries have been moved to nameVecs. Release the per-chunk name
+  // data and the deduplication maps now rather than at the end of init, as
+  // together they dominate peak memory usage when merging large indexes.
+  uint32_t num = 0;
+  for (auto &map : maps) {
+    num += map.size();
+    map = DenseMap<CachedHashStringRef, size_t>();
+  }
+  parallelForEach(inputChunks, [](InputChunk &inputChunk) {
+    inputChunk.nameData = SmallVector<NameData, 0>();
+  });
+
   // Compute entry offsets in parallel. First, compute offsets relative to the
   // current shard.
   uint32_t offsets[numShards];
@@ -3180,9 +3192,6 @@ std::pair<uint32_t, uint32_t> DebugNamesBaseSection::computeEntryPool(
   });
 
   // Return (entry pool size, number of entries).
-  uint32_t num = 0;
-  for (auto &map : maps)
-    num += map.size();
   return {offsets[numShards - 1], num};
 }
 
@@ -3219,6 +3228,11 @@ void DebugNamesBaseSection::init(
 
   // Compute section header (except unit_length), abbrev table, and entry pool.
   computeHdrAndAbbrevTable(inputChunks);
+  // The parsed input indexes are not needed past this point. Free them before
+  // computeEntryPool builds the merged name table.
+  parallelForEach(inputChunks, [](InputChunk &inputChunk) {
+    inputChunk.llvmDebugNames.reset();
+  });
   uint32_t entryPoolSize;
   std::tie(entryPoolSize, hdr.NameCount) = computeEntryPool(inputChunks);
   hdr.BucketCount = dwarf::getDebugNamesBucketCount(hdr.NameCount);
@@ -3476,11 +3490,11 @@ readPubNamesAndTypes(Ctx &ctx, const LLDDwarfObj<ELFT> &obj,
 }
 
 // Create a list of symbols from a given list of symbol names and types
-// by uniquifying them by name.
+// by uniquifying them by name. nameAttrs is consumed.
 static std::pair<SmallVector<GdbIndexSection::GdbSymbol, 0>, size_t>
 createSymbols(
     Ctx &ctx,
-    ArrayRef<SmallVector<GdbIndexSection::NameAttrEntry, 0>> nameAttrs,
+    MutableArrayRef<SmallVector<GdbIndexSection::NameAttrEntry, 0>> nameAttrs,
     const SmallVector<GdbIndexSection::GdbChunk, 0> &chunks) {
   using GdbSymbol = GdbIndexSection::GdbSymbol;
   using NameAttrEntry = GdbIndexSection::NameAttrEntry;
@@ -3523,18 +3537,27 @@ createSymbols(
     }
   });
 
+  // The maps and the per-file name lists are no longer needed. Free them before
+  // flattening the shards so that they do not add to the peak memory usage.
+  map.reset();
+  parallelForEach(nameAttrs, [](SmallVector<NameAttrEntry, 0> &entries) {
+    entries = SmallVector<NameAttrEntry, 0>();
+  });
+
   size_t numSymbols = 0;
   for (ArrayRef<GdbSymbol> v : ArrayRef(symbols.get(), numShards))
     numSymbols += v.size();
 
-  // The return type is a flattened vector, so we'll copy each vector
-  // contents to Ret.
+  // The return type is a flattened vector, so we'll move each vector
+  // contents to Ret, releasing each shard as soon as it has been moved.
   SmallVector<GdbSymbol, 0> ret;
   ret.reserve(numSymbols);
   for (SmallVector<GdbSymbol, 0> &vec :
-       MutableArrayRef(symbols.get(), numShards))
+       MutableArrayRef(symbols.get(), numShards)) {
     for (GdbSymbol &sym : vec)
       ret.push_back(std::move(sym));
+    vec = SmallVector<GdbSymbol, 0>();
+  }
 
   // CU vectors and symbol names are adjacent in the output file.
   // We can compute their offsets in the output file now.
@@ -3552,7 +3575,7 @@ createSymbols(
     Err(ctx) << "--gdb-index: constant pool size (" << off
              << ") exceeds UINT32_MAX";
 
-  return {ret, off};
+  return {std::move(ret), off};
 }
 
 // Returns a newly-created .gdb_index section.
@@ -1085,13 +1085,40 @@ static DenseMap<const InputSectionBase *, int> buildSectionOrder(Ctx &ctx) {
   DenseMap<const InputSectionBase *, int> sectionOrder;
   if (ctx.arg.bpStartupFunctionSort || ctx.arg.bpFunctionOrderForCompression ||
       ctx.arg.bpDataOrderForCompression) {
+    // With a call graph profile, lay out the hot sections named by it first
+    // and order only the remaining sections for compression.
+    DenseMap<const InputSectionBase *, int> hotOrder;
+    if (ctx.arg.bpWithCallGraphProfile && !ctx.arg.callGraphProfile.empty())
+      hotOrder = computeCallGraphProfileOrder(ctx);
+
     TimeTraceScope timeScope("Balanced Partitioning Section Orderer");
     sectionOrder = runBalancedPartitioning(
         ctx, ctx.arg.bpStartupFunctionSort ? ctx.arg.irpgoProfilePath : "",
         ctx.arg.bpFunctionOrderForCompression,
         ctx.arg.bpDataOrderForCompression,
         ctx.arg.bpCompressionSortStartupFunctions,
-        ctx.arg.bpVerboseSectionOrderer);
+        ctx.arg.bpVerboseSectionOrderer, hotOrder);
+
+    if (!hotOrder.empty()) {
+      // Both orders use negative priorities. Shift the hot order below the
+      // balanced partitioning order so that hot sections come first.
+      int minPrio = 0;
+      for (auto [sec, prio] : hotOrder)
+        minPrio = std::min(minPrio, prio);
+      int shift = -(int)sectionOrder.size() - (int)hotOrder.size() - minPrio;
+      for (auto [sec, prio] : hotOrder)
+        sectionOrder[sec] = prio + shift;
+      if (ctx.arg.bpVerboseSectionOrderer) {
+        uint64_t hotSize = 0;
+        for (auto [sec, prio] : hotOrder)
+          hotSize += sec->getSize();
+        Msg(ctx) << "ordered " << hotOrder.size()
+                 << " sections (" << hotSize
+                 << " bytes) using the call graph profile before "
+                 << (sectionOrder.size() - hotOrder.size())
+                 << " sections ordered by balanced partitioning";
+      }
+    }
   } else if (!ctx.arg.callGraphProfile.empty()) {
     sectionOrder = computeCallGraphProfileOrder(ctx);
   }
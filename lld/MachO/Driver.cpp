@@ -370,21 +370,52 @@ static InputFile *addFile(StringRef path, LoadType loadType,
       // we already found that it contains an ObjC symbol.
       if (readFile(path)) {
         Error e = Error::success();
-        for (const object::Archive::Child &c : file->getArchive().children(e)) {
-          Expected<MemoryBufferRef> mb = c.getMemoryBufferRef();
-          if (!mb) {
-            // We used to create broken repro tarballs that only included those
-            // object files from thin archives that ended up being used.
-            if (config->warnThinArchiveMissingMembers)
-              warn(toString(file) + ": -ObjC failed to open archive member: " +
-                   toString(mb.takeError()));
-            else
+        std::vector<object::Archive::Child> children;
+        for (const object::Archive::Child &c : file->getArchive().children(e))
+          children.push_back(c);
+
+        // Scanning every member's load commands for ObjC sections is
+        // expensive for large archives, so scan Mach-O object members in
+        // parallel first. Members are still fetched below in archive order.
+        // Thin archive members are opened lazily, which is not thread-safe,
+        // and bitcode members may report errors, so those, as well as members
+        // that failed to open, are left to the serial loop.
+        enum class ObjCScan : uint8_t { Unknown, No, Yes };
+        std::vector<ObjCScan> scans(children.size(), ObjCScan::Unknown);
+        if (!file->getArchive().isThin()) {
+          parallelFor(0, children.size(), [&](size_t i) {
+            Expected<MemoryBufferRef> mb = children[i].getMemoryBufferRef();
+            if (!mb) {
               llvm::consumeError(mb.takeError());
-            continue;
-          }
+              return;
+            }
+            if (identify_magic(mb->getBuffer()) == file_magic::macho_object)
+              scans[i] = hasObjCSection(*mb) ? ObjCScan::Yes : ObjCScan::No;
+          });
+        }
 
-          if (!hasObjCSection(*mb))
+        for (size_t i = 0, n = children.size(); i != n; ++i) {
+          if (scans[i] == ObjCScan::No)
             continue;
+          const object::Archive::Child &c = children[i];
+          if (scans[i] == ObjCScan::Unknown) {
+            Expected<MemoryBufferRef> mb = c.getMemoryBufferRef();
+            if (!mb) {
+              // We used to create broken repro tarballs that only included
+              // those object files from thin archives that ended up being
+              // used.
+              if (config->warnThinArchiveMissingMembers)
+                warn(toString(file) +
+                     ": -ObjC failed to open archive member: " +
+                     toString(mb.takeError()));
+              else
+                llvm::consumeError(mb.takeError());
+              continue;
+            }
+
+            if (!hasObjCSection(*mb))
+              continue;
+          }
           if (Error e = file->fetch(c, "-ObjC"))
             error(toString(file) + ": -ObjC failed to load archive member: " +
                   toString(std::move(e)));
@@ -58,7 +58,7 @@ public:
 
   void openFile();
   void writeSections();
-  void applyOptimizationHints();
+  void applyOptimizationHints(parallel::TaskGroup &tg);
   void buildFixupChains();
   void writeUuid();
   void writeCodeSignature();
@@ -1209,16 +1209,23 @@ void Writer::writeSections() {
   });
 }
 
-void Writer::applyOptimizationHints() {
+// The hints are applied by tasks spawned in \p tg, so that the calling thread
+// can do other work until tg is synced.
+void Writer::applyOptimizationHints(parallel::TaskGroup &tg) {
   if (config->arch() != AK_arm64 || config->ignoreOptimizationHints)
     return;
 
   uint8_t *buf = buffer->getBufferStart();
-  TimeTraceScope timeScope("Apply linker optimization hints");
-  parallelForEach(inputFiles, [buf](const InputFile *file) {
-    if (const auto *objFile = dyn_cast<ObjFile>(file))
-      target->applyOptimizationHints(buf, *objFile);
-  });
+  constexpr size_t filesPerTask = 16;
+  for (size_t begin = 0, e = inputFiles.size(); begin < e;
+       begin += filesPerTask) {
+    size_t end = std::min(begin + filesPerTask, e);
+    tg.spawn([buf, begin, end] {
+      for (size_t i = begin; i != end; ++i)
+        if (const auto *objFile = dyn_cast<ObjFile>(inputFiles[i]))
+          target->applyOptimizationHints(buf, *objFile);
+    });
+  }
 }
 
 // In order to utilize multiple cores, we first split the buffer into chunks,
@@ -1304,8 +1311,17 @@ void Writer::writeOutputFile() {
   if (errorCount())
     return;
   writeSections();
-  applyOptimizationHints();
-  buildFixupChains();
+  {
+    // Optimization hints only rewrite instructions, while fixup chains are
+    // only threaded through pointer slots, so the two touch disjoint bytes.
+    // Build the (serial) fixup chains on this thread while worker threads
+    // apply the hints.
+    parallel::TaskGroup tg;
+    applyOptimizationHints(tg);
+    buildFixupChains();
+    TimeTraceScope timeScope("Wait for linker optimization hints");
+    tg.sync();
+  }
   if (config->generateUuid)
     writeUuid();
   writeCodeSignature();
@@ -0,0 +1,94 @@
+# REQUIRES: aarch64
+## Check that --bp-compression-sort composes with a call graph profile: the
+## sections named by the profile are laid out first in call graph order and
+## balanced partitioning only orders the remaining sections.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=aarch64 a.s -o a.o
+# RUN: llvm-mc -filetype=obj -triple=aarch64 b.s -o b.o
+
+## --call-graph-ordering-file.
+# RUN: ld.lld a.o -o out --call-graph-ordering-file=cg.txt \
+# RUN:   --bp-compression-sort=function --verbose-bp-section-orderer \
+# RUN:   > msg.txt 2> err.txt
+# RUN: llvm-nm -jn out | FileCheck %s --check-prefix=ORDER
+# RUN: FileCheck %s --check-prefix=MSG < msg.txt
+# RUN: FileCheck %s --check-prefix=BP < err.txt
+
+## The .llvm.call-graph-profile section, with an explicit
+## --call-graph-profile-sort.
+# RUN: ld.lld a.o b.o -o out2 --call-graph-profile-sort=cdsort \
+# RUN:   --bp-compression-sort=function --verbose-bp-section-orderer \
+# RUN:   > msg2.txt 2> err2.txt
+# RUN: llvm-nm -jn out2 | FileCheck %s --check-prefix=ORDER
+# RUN: FileCheck %s --check-prefix=MSG < msg2.txt
+# RUN: FileCheck %s --check-prefix=BP < err2.txt
+
+# ORDER:      hot_a
+# ORDER-NEXT: hot_b
+
+# MSG: ordered 2 sections (16 bytes) using the call graph profile before 4 sections ordered by balanced partitioning
+
+# BP: Functions for compression: 4
+
+## Without an explicit --call-graph-profile-sort, the embedded profile does not
+## change the balanced partitioning order.
+# RUN: ld.lld a.o b.o -o out3 --bp-compression-sort=function \
+# RUN:   --verbose-bp-section-orderer > msg3.txt 2> err3.txt
+# RUN: count 0 < msg3.txt
+# RUN: FileCheck %s --check-prefix=BP-ALL < err3.txt
+
+# BP-ALL: Functions for compression: 6
+
+## --bp-startup-sort=function orders the hot code itself.
+# RUN: not ld.lld a.o -o /dev/null --bp-startup-sort=function \
+# RUN:   --irpgo-profile=/dev/null --call-graph-ordering-file=cg.txt 2>&1 \
+# RUN:   | FileCheck %s --check-prefix=STARTUP-ERR
+
+# STARTUP-ERR: error: --bp-startup-sort=function is incompatible with --call-graph-ordering-file
+
+#--- cg.txt
+hot_a hot_b 100
+
+#--- a.s
+.section .text._start,"ax",@progbits
+.globl _start
+_start:
+  mov x0, #0
+  ret
+
+.section .text.cold_a,"ax",@progbits
+.globl cold_a
+cold_a:
+  add x0, x0, #1
+  add x0, x0, #2
+  ret
+
+.section .text.cold_b,"ax",@progbits
+.globl cold_b
+cold_b:
+  add x0, x0, #1
+  add x0, x0, #3
+  ret
+
+.section .text.cold_c,"ax",@progbits
+.globl cold_c
+cold_c:
+  add x0, x0, #2
+  add x0, x0, #3
+  ret
+
+.section .text.hot_a,"ax",@progbits
+.globl hot_a
+hot_a:
+  bl hot_b
+  ret
+
+.section .text.hot_b,"ax",@progbits
+.globl hot_b
+hot_b:
+  add x0, x0, #4
+  ret
+
+#--- b.s
+.cg_profile hot_a, hot_b, 100
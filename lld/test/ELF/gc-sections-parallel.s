@@ -0,0 +1,79 @@
+# REQUIRES: x86
+## --parallel-gc-sections marks the same sections, section pieces, symbols and
+## shared libraries live as the serial mark phase.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a.s -o a.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 b.s -o b.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 c.s -o c.o
+# RUN: ld.lld -shared -soname=b.so b.o -o b.so
+# RUN: ld.lld -shared -soname=c.so c.o -o c.so
+
+# RUN: ld.lld --gc-sections --print-gc-sections --as-needed a.o b.so c.so \
+# RUN:   -o serial > serial.txt
+# RUN: ld.lld --gc-sections --print-gc-sections --as-needed a.o b.so c.so \
+# RUN:   --parallel-gc-sections --threads=4 -o parallel > parallel.txt
+# RUN: FileCheck %s --check-prefix=GC < parallel.txt
+# RUN: diff serial.txt parallel.txt
+# RUN: cmp serial parallel
+
+# RUN: llvm-readelf -d parallel | FileCheck %s --check-prefix=NEEDED
+# RUN: llvm-readelf -p .rodata parallel | FileCheck %s --check-prefix=STR
+# RUN: llvm-nm parallel | FileCheck %s --check-prefix=SYM
+
+# GC:     removing unused section a.o:(.text.dead_fn)
+# GC-NOT: removing
+
+## Only the library referenced from a live section is needed.
+# NEEDED:     (NEEDED) Shared library: [b.so]
+# NEEDED-NOT: c.so
+
+## Only the string referenced from a live section is kept.
+# STR:     live string
+# STR-NOT: dead string
+
+## Only the undefined symbol referenced from a live section is used.
+# SYM-NOT: undef_dead
+# SYM:     w undef_live
+# SYM-NOT: undef_dead
+
+#--- a.s
+.globl _start
+.weak undef_live, undef_dead
+
+.section .text._start,"ax",@progbits
+_start:
+  call live_fn
+  call shared_live
+  leaq .Llive_str(%rip), %rax
+  .reloc ., R_X86_64_NONE, undef_live
+  ret
+
+.section .text.live_fn,"ax",@progbits
+live_fn:
+  ret
+
+.section .text.dead_fn,"ax",@progbits
+dead_fn:
+  call shared_dead
+  leaq .Ldead_str(%rip), %rax
+  .reloc ., R_X86_64_NONE, undef_dead
+  ret
+
+.section .rodata.str1.1,"aMS",@progbits,1
+.Llive_str:
+  .asciz "live string"
+.Ldead_str:
+  .asciz "dead string"
+
+#--- b.s
+.globl shared_live
+.type shared_live,@function
+shared_live:
+  ret
+
+#--- c.s
+.globl shared_dead
+.type shared_dead,@function
+shared_dead:
+  ret
@@ -0,0 +1,206 @@
+//===- ADTBM.cpp ----------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Microbenchmarks for the core ADT containers that dominate compile time:
+// SmallVector growth, DenseMap and StringMap insertion and lookup, FoldingSet
+// uniquing and wide APInt arithmetic. Run with --benchmark_format=json to get
+// results in a stable format that can be tracked over time.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/APInt.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/FoldingSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Allocator.h"
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+static uint64_t xorshift(uint64_t State) {
+  State ^= State << 13;
+  State ^= State >> 7;
+  State ^= State << 17;
+  return State;
+}
+
+static std::vector<uint64_t> generateKeys(int64_t N, uint64_t Seed) {
+  std::vector<uint64_t> Keys(N);
+  for (uint64_t &K : Keys)
+    K = Seed = xorshift(Seed);
+  return Keys;
+}
+
+static void BM_SmallVectorPushBack(benchmark::State &State) {
+  const int64_t N = State.range(0);
+  for (auto _ : State) {
+    SmallVector<unsigned, 8> V;
+    for (int64_t I = 0; I < N; ++I)
+      V.push_back(I);
+    benchmark::DoNotOptimize(V.data());
+  }
+  State.SetItemsProcessed(State.iterations() * N);
+}
+BENCHMARK(BM_SmallVectorPushBack)->Arg(4)->Arg(64)->Arg(4096);
+
+static void BM_DenseMapInsert(benchmark::State &State) {
+  std::vector<uint64_t> Keys = generateKeys(State.range(0), 0x12345678);
+  for (auto _ : State) {
+    DenseMap<uint64_t, unsigned> M;
+    for (uint64_t K : Keys)
+      M.try_emplace(K, 0);
+    benchmark::DoNotOptimize(M.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+BENCHMARK(BM_DenseMapInsert)->Arg(64)->Arg(4096)->Arg(1 << 18);
+
+// Look up a mix of present and absent keys. Arg(1) is the percentage of
+// lookups that hit.
+static void BM_DenseMapLookup(benchmark::State &State) {
+  const int64_t N = State.range(0);
+  std::vector<uint64_t> Keys = generateKeys(N, 0x12345678);
+  std::vector<uint64_t> Misses = generateKeys(N, 0x87654321);
+  DenseMap<uint64_t, unsigned> M;
+  for (uint64_t K : Keys)
+    M.try_emplace(K, 0);
+  std::vector<uint64_t> Queries(N);
+  for (int64_t I = 0; I < N; ++I)
+    Queries[I] = (I % 100) < State.range(1) ? Keys[I] : Misses[I];
+  for (auto _ : State) {
+    unsigned Found = 0;
+    for (uint64_t Q : Queries)
+      Found += M.contains(Q);
+    benchmark::DoNotOptimize(Found);
+  }
+  State.SetItemsProcessed(State.iterations() * N);
+}
+BENCHMARK(BM_DenseMapLookup)
+    ->Args({4096, 100})
+    ->Args({4096, 0})
+    ->Args({1 << 18, 100})
+    ->Args({1 << 18, 10});
+
+static std::vector<std::string> generateStrings(int64_t N) {
+  std::vector<std::string> Strs;
+  Strs.reserve(N);
+  uint64_t Seed = 0xdeadbeef;
+  for (int64_t I = 0; I < N; ++I) {
+    Seed = xorshift(Seed);
+    Strs.push_back("_ZN4llvm" + std::to_string(Seed) + "E");
+  }
+  return Strs;
+}
+
+static void BM_StringMapInsert(benchmark::State &State) {
+  std::vector<std::string> Strs = generateStrings(State.range(0));
+  for (auto _ : State) {
+    StringMap<unsigned> M;
+    for (const std::string &S : Strs)
+      M.try_emplace(S, 0);
+    benchmark::DoNotOptimize(M.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Strs.size());
+}
+BENCHMARK(BM_StringMapInsert)->Arg(64)->Arg(4096)->Arg(1 << 16);
+
+static void BM_StringMapLookup(benchmark::State &State) {
+  std::vector<std::string> Strs = generateStrings(State.range(0));
+  StringMap<unsigned> M;
+  for (const std::string &S : Strs)
+    M.try_emplace(S, 0);
+  for (auto _ : State) {
+    unsigned Found = 0;
+    for (const std::string &S : Strs)
+      Found += M.contains(S);
+    benchmark::DoNotOptimize(Found);
+  }
+  State.SetItemsProcessed(State.iterations() * Strs.size());
+}
+BENCHMARK(BM_StringMapLookup)->Arg(64)->Arg(4096)->Arg(1 << 16);
+
+namespace {
+struct Node : FoldingSetNode {
+  uint64_t A, B;
+  Node(uint64_t A, uint64_t B) : A(A), B(B) {}
+  void Profile(FoldingSetNodeID &ID) const {
+    ID.AddInteger(A);
+    ID.AddInteger(B);
+  }
+};
+} // namespace
+
+// Unique nodes the way LLVMContext and SelectionDAG do: profile the operands,
+// look the node up and create it if it does not exist yet. Every key is
+// queried twice, so half of the lookups hit.
+static void BM_FoldingSetUnique(benchmark::State &State) {
+  std::vector<uint64_t> Keys = generateKeys(State.range(0), 0x12345678);
+  for (auto _ : State) {
+    BumpPtrAllocator Alloc;
+    FoldingSet<Node> Set;
+    for (unsigned Round = 0; Round != 2; ++Round) {
+      for (uint64_t K : Keys) {
+        FoldingSetNodeID ID;
+        ID.AddInteger(K);
+        ID.AddInteger(K >> 3);
+        void *InsertPos;
+        if (!Set.FindNodeOrInsertPos(ID, InsertPos))
+          Set.InsertNode(new (Alloc) Node(K, K >> 3), InsertPos);
+      }
+    }
+    benchmark::DoNotOptimize(Set.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size() * 2);
+}
+BENCHMARK(BM_FoldingSetUnique)->Arg(64)->Arg(4096)->Arg(1 << 16);
+
+// Arithmetic on APInts wider than 64 bits, which take the out-of-line slow
+// paths.
+static std::vector<APInt> generateAPInts(unsigned BitWidth, int64_t N) {
+  std::vector<APInt> Vals;
+  Vals.reserve(N);
+  uint64_t Seed = 0xcafebabe;
+  SmallVector<uint64_t, 4> Words(APInt::getNumWords(BitWidth));
+  for (int64_t I = 0; I < N; ++I) {
+    for (uint64_t &W : Words)
+      W = Seed = xorshift(Seed);
+    // Keep the values non-zero so they can be used as divisors.
+    Vals.emplace_back(BitWidth, Words);
+    Vals.back().setBit(0);
+  }
+  return Vals;
+}
+
+static void BM_APIntMul(benchmark::State &State) {
+  std::vector<APInt> Vals = generateAPInts(State.range(0), 1024);
+  for (auto _ : State) {
+    for (size_t I = 0, E = Vals.size() - 1; I != E; ++I)
+      benchmark::DoNotOptimize(Vals[I] * Vals[I + 1]);
+  }
+  State.SetItemsProcessed(State.iterations() * (Vals.size() - 1));
+}
+BENCHMARK(BM_APIntMul)->Arg(128)->Arg(256)->Arg(1024);
+
+static void BM_APIntUDiv(benchmark::State &State) {
+  std::vector<APInt> Vals = generateAPInts(State.range(0), 1024);
+  // Divide by values of half the width to exercise the long division loop.
+  std::vector<APInt> Divisors;
+  for (const APInt &V : Vals)
+    Divisors.push_back(V.lshr(State.range(0) / 2) | 1);
+  for (auto _ : State) {
+    for (size_t I = 0, E = Vals.size(); I != E; ++I)
+      benchmark::DoNotOptimize(Vals[I].udiv(Divisors[I]));
+  }
+  State.SetItemsProcessed(State.iterations() * Vals.size());
+}
+BENCHMARK(BM_APIntUDiv)->Arg(128)->Arg(256)->Arg(1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,71 @@
+//===- GSYMLookupBM.cpp ---------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Microbenchmark for address lookups in a memory mapped GSYM file, which is
+// what symbolizers do for every address they are asked about.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/DebugInfo/GSYM/GsymCreator.h"
+#include "llvm/DebugInfo/GSYM/GsymReader.h"
+#include "llvm/DebugInfo/GSYM/OutputAggregator.h"
+#include "llvm/Support/FileSystem.h"
+
+using namespace llvm;
+using namespace llvm::gsym;
+
+static constexpr uint64_t BaseAddr = 0x100000;
+static constexpr uint64_t FuncSize = 0x40;
+
+// Create a GSYM file with \p NumFuncs functions, each with a small line table,
+// and save it to a temporary file that is memory mapped by GsymReader.
+static std::string createGsymFile(int64_t NumFuncs) {
+  GsymCreator GC;
+  uint32_t FileIdx = GC.insertFile("/tmp/main.cpp");
+  for (int64_t I = 0; I < NumFuncs; ++I) {
+    uint64_t Addr = BaseAddr + I * FuncSize;
+    FunctionInfo FI(Addr, FuncSize,
+                    GC.insertString("func" + std::to_string(I)));
+    FI.OptLineTable = LineTable();
+    for (uint64_t Off = 0; Off < FuncSize; Off += 0x10)
+      FI.OptLineTable->push(LineEntry(Addr + Off, FileIdx, I * 10 + Off));
+    GC.addFunctionInfo(std::move(FI));
+  }
+  OutputAggregator Null(nullptr);
+  cantFail(GC.finalize(Null));
+
+  SmallString<128> Path;
+  cantFail(errorCodeToError(
+      sys::fs::createTemporaryFile("gsym-lookup", "gsym", Path)));
+  cantFail(GC.save(Path, llvm::endianness::native));
+  return std::string(Path);
+}
+
+static void BM_GsymLookup(benchmark::State &State) {
+  const int64_t NumFuncs = State.range(0);
+  std::string Path = createGsymFile(NumFuncs);
+  {
+    GsymReader GR = cantFail(GsymReader::openFile(Path));
+    uint64_t Idx = 0;
+    for (auto _ : State) {
+      // Visit functions in a scattered order so lookups are not trivially
+      // cached.
+      Idx = (Idx + 7919) % NumFuncs;
+      Expected<LookupResult> LR = GR.lookup(BaseAddr + Idx * FuncSize + 0x18);
+      if (!LR)
+        consumeError(LR.takeError());
+      benchmark::DoNotOptimize(LR);
+    }
+  }
+  sys::fs::remove(Path);
+}
+
+BENCHMARK(BM_GsymLookup)->Arg(1000)->Arg(100 * 1000)->Arg(1000 * 1000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,141 @@
+//===- IRBM.cpp -----------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Microbenchmarks for core IR operations: creating and erasing instructions
+// with IRBuilder, walking use lists and round-tripping a module through
+// bitcode. Run with --benchmark_format=json to get results in a stable format
+// that can be tracked over time.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include <memory>
+
+using namespace llvm;
+
+// Create a function taking two i64 arguments whose body is a chain of
+// \p NumInstrs arithmetic instructions, each using the previous result and
+// one of the arguments.
+static Function *createChain(Module &M, unsigned NumInstrs) {
+  LLVMContext &C = M.getContext();
+  Type *I64 = Type::getInt64Ty(C);
+  auto *FTy = FunctionType::get(I64, {I64, I64}, /*isVarArg=*/false);
+  Function *F = Function::Create(FTy, GlobalValue::ExternalLinkage,
+                                 "f" + Twine(M.size()), M);
+  IRBuilder<> B(BasicBlock::Create(C, "entry", F));
+  Value *A0 = F->getArg(0);
+  Value *A1 = F->getArg(1);
+  Value *V = A0;
+  for (unsigned I = 0; I != NumInstrs; ++I) {
+    switch (I % 3) {
+    case 0:
+      V = B.CreateAdd(V, A1);
+      break;
+    case 1:
+      V = B.CreateXor(V, A0);
+      break;
+    default:
+      V = B.CreateMul(V, A1);
+      break;
+    }
+  }
+  B.CreateRet(V);
+  return F;
+}
+
+static void BM_IRBuilderCreateErase(benchmark::State &State) {
+  LLVMContext C;
+  Module M("bench", C);
+  const unsigned NumInstrs = State.range(0);
+  for (auto _ : State) {
+    Function *F = createChain(M, NumInstrs);
+    F->eraseFromParent();
+  }
+  State.SetItemsProcessed(State.iterations() * NumInstrs);
+}
+BENCHMARK(BM_IRBuilderCreateErase)->Arg(16)->Arg(1024)->Arg(64 * 1024);
+
+// Walk the use lists of the function arguments. The second argument is used by
+// the add and the mul of every step, about two thirds of the instructions. The
+// first argument is used by the xor of every step and by the first add.
+static void BM_UseListWalk(benchmark::State &State) {
+  LLVMContext C;
+  Module M("bench", C);
+  Function *F = createChain(M, State.range(0));
+  for (auto _ : State) {
+    unsigned NumUsers = 0;
+    for (Argument &A : F->args())
+      for (User *U : A.users())
+        NumUsers += isa<Instruction>(U);
+    benchmark::DoNotOptimize(NumUsers);
+  }
+}
+BENCHMARK(BM_UseListWalk)->Arg(1024)->Arg(64 * 1024);
+
+static void BM_ReplaceAllUsesWith(benchmark::State &State) {
+  LLVMContext C;
+  Module M("bench", C);
+  Function *F = createChain(M, State.range(0));
+  Argument *A0 = F->getArg(0);
+  Argument *A1 = F->getArg(1);
+  for (auto _ : State) {
+    // Every use of either argument moves to A1 and then back to A0, so each
+    // step moves all argument uses twice and leaves all of them on A0.
+    A0->replaceAllUsesWith(A1);
+    A1->replaceUsesWithIf(A0, [](Use &) { return true; });
+  }
+}
+BENCHMARK(BM_ReplaceAllUsesWith)->Arg(1024)->Arg(64 * 1024);
+
+static void BM_BitcodeWrite(benchmark::State &State) {
+  LLVMContext C;
+  Module M("bench", C);
+  for (int64_t I = 0; I < State.range(0); ++I)
+    createChain(M, 256);
+  for (auto _ : State) {
+    SmallVector<char, 0> Buffer;
+    raw_svector_ostream OS(Buffer);
+    WriteBitcodeToFile(M, OS);
+    benchmark::DoNotOptimize(Buffer.data());
+  }
+}
+BENCHMARK(BM_BitcodeWrite)->Arg(16)->Arg(256);
+
+static void BM_BitcodeRead(benchmark::State &State) {
+  SmallVector<char, 0> Buffer;
+  {
+    LLVMContext C;
+    Module M("bench", C);
+    for (int64_t I = 0; I < State.range(0); ++I)
+      createChain(M, 256);
+    raw_svector_ostream OS(Buffer);
+    WriteBitcodeToFile(M, OS);
+  }
+  MemoryBufferRef Ref(StringRef(Buffer.data(), Buffer.size()), "bench");
+  for (auto _ : State) {
+    LLVMContext C;
+    Expected<std::unique_ptr<Module>> M = parseBitcodeFile(Ref, C);
+    if (!M) {
+      State.SkipWithError(toString(M.takeError()).c_str());
+      break;
+    }
+    benchmark::DoNotOptimize(M->get());
+  }
+}
+BENCHMARK(BM_BitcodeRead)->Arg(16)->Arg(256);
+
+BENCHMARK_MAIN();
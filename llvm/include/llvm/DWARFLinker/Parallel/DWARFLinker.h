@@ -127,7 +127,9 @@ public:
 
   /// Set output DWARF handler. Result of linking DWARF is set of sections
   /// containing final debug info. DWARFLinkerBase::link() pass generated
-  /// sections using specified \p SectionHandler.
+  /// sections using specified \p SectionHandler. The contents of a compile
+  /// unit section may be released once \p SectionHandler returns, so the
+  /// handler must copy the data it needs.
   virtual void setOutputDWARFHandler(const Triple &TargetTriple,
                                      SectionHandlerTy SectionHandler) = 0;
 };
@@ -32,7 +32,8 @@ public:
     F_executable = 1,
 
     /// Don't use mmap and instead write an in-memory buffer to a file when this
-    /// buffer is closed.
+    /// buffer is closed. For regular files, the buffer is written to a
+    /// temporary file that atomically replaces the destination.
     F_no_mmap = 2,
   };
 
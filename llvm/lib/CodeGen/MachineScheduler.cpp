@@ -57,6 +57,7 @@
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/GraphWriter.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetMachine.h"
 #include <algorithm>
@@ -802,7 +803,14 @@ void MachineSchedulerBase::scheduleRegions(ScheduleDAGInstrs &Scheduler,
 
       // Schedule a region: possibly reorder instructions.
       // This invalidates the original region iterators.
-      Scheduler.schedule();
+      {
+        TimeTraceScope TimeScope("MachineSchedulerRegion", [&] {
+          return (MF->getName() + ":%bb." + Twine(MBB->getNumber()) + " (" +
+                  Twine(NumRegionInstrs) + " instrs)")
+              .str();
+        });
+        Scheduler.schedule();
+      }
 
       // Close the current region.
       Scheduler.exitRegion();
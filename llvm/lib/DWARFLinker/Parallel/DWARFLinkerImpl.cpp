@@ -1408,6 +1408,12 @@ void DWARFLinkerImpl::writeCompileUnitsToTheOutput() {
     Sections.forEach([&](std::shared_ptr<SectionDescriptor> OutSection) {
       // Emit section content.
       SectionHandler(OutSection);
+
+      // The handler has consumed the section, release its data bits so that
+      // the output of all units is not kept in memory twice. Statistic
+      // printing needs the sizes of the .debug_info sections later.
+      if (!GlobalData.getOptions().Statistics)
+        OutSection->clearSectionContent();
     });
   });
 }
@@ -657,11 +657,6 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
 
   DWPStringPool Strings(Out, StrSection);
 
-  SmallVector<OwningBinary<object::ObjectFile>, 128> Objects;
-  Objects.reserve(Inputs.size());
-
-  std::deque<SmallString<32>> UncompressedSections;
-
   for (const auto &Input : Inputs) {
     auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
     if (!ErrOrObj) {
@@ -671,8 +666,13 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
                           });
     }
 
-    auto &Obj = *ErrOrObj->getBinary();
-    Objects.push_back(std::move(*ErrOrObj));
+    // The input and its decompressed sections are only needed while this
+    // input is processed: section contents are copied into the streamer and
+    // the string pool keeps its own copies of unique strings. Releasing them
+    // here bounds memory usage to a single input instead of all of them.
+    OwningBinary<object::ObjectFile> Object = std::move(*ErrOrObj);
+    auto &Obj = *Object.getBinary();
+    std::deque<SmallString<32>> UncompressedSections;
 
     UnitIndexEntry CurEntry = {};
 
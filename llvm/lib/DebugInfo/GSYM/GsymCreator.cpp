@@ -11,11 +11,13 @@
 #include "llvm/DebugInfo/GSYM/LineTable.h"
 #include "llvm/DebugInfo/GSYM/OutputAggregator.h"
 #include "llvm/MC/StringTableBuilder.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <algorithm>
 #include <cassert>
 #include <functional>
+#include <numeric>
 #include <vector>
 
 using namespace llvm;
@@ -275,9 +277,25 @@ llvm::Error GsymCreator::finalize(OutputAggregator &Out) {
   // object.
   if (!IsSegment) {
     if (NumBefore > 1) {
-      // Sort function infos so we can emit sorted functions. Use stable sort to
-      // ensure determinism.
-      llvm::stable_sort(Funcs);
+      // Sort function infos so we can emit sorted functions. Comparing
+      // function infos with line tables and inline info is expensive, so sort
+      // their indexes in parallel. Ties are broken by the original position,
+      // which gives the same order as a stable sort to ensure determinism.
+      std::vector<size_t> Order(NumBefore);
+      std::iota(Order.begin(), Order.end(), 0);
+      parallelSort(Order, [&](size_t LHS, size_t RHS) {
+        if (Funcs[LHS] < Funcs[RHS])
+          return true;
+        if (Funcs[RHS] < Funcs[LHS])
+          return false;
+        return LHS < RHS;
+      });
+      std::vector<FunctionInfo> SortedFuncs;
+      SortedFuncs.reserve(NumBefore);
+      for (size_t Idx : Order)
+        SortedFuncs.emplace_back(std::move(Funcs[Idx]));
+      Funcs = std::move(SortedFuncs);
+
       std::vector<FunctionInfo> FinalizedFuncs;
       FinalizedFuncs.reserve(Funcs.size());
       FinalizedFuncs.emplace_back(std::move(Funcs.front()));
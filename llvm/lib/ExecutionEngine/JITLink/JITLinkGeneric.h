@@ -14,6 +14,8 @@
 #define LIB_EXECUTIONENGINE_JITLINK_JITLINKGENERIC_H
 
 #include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/Parallel.h"
 
 #define DEBUG_TYPE "jitlink"
 
@@ -125,6 +127,10 @@ public:
   }
 
 private:
+  /// The minimum number of edges in a section for its blocks to be fixed up
+  /// in parallel.
+  static constexpr size_t ParallelFixupThreshold = 4096;
+
   const LinkerImpl &impl() const {
     return static_cast<const LinkerImpl &>(*this);
   }
@@ -135,11 +141,9 @@ private:
     for (auto &Sec : G.sections()) {
       bool NoAllocSection = Sec.getMemLifetime() == orc::MemLifetime::NoAlloc;
 
+      SmallVector<Block *, 0> Blocks;
+      size_t NumEdges = 0;
       for (auto *B : Sec.blocks()) {
-        LLVM_DEBUG(dbgs() << "  " << *B << ":\n");
-
-        // Copy Block data and apply fixups.
-        LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
         assert((!B->isZeroFill() || all_of(B->edges(),
                                            [](const Edge &E) {
                                              return E.getKind() ==
@@ -149,33 +153,76 @@ private:
 
         // If this is a no-alloc section then copy the block content into
         // memory allocated on the Graph's allocator (if it hasn't been
-        // already).
+        // already). The allocator is not thread safe, so do this before
+        // applying fixups.
         if (NoAllocSection)
           (void)B->getMutableContent(G);
 
-        for (auto &E : B->edges()) {
-
-          // Skip non-relocation edges.
-          if (!E.isRelocation())
-            continue;
-
-          // If B is a block in a Standard or Finalize section then make sure
-          // that no edges point to symbols in NoAlloc sections.
-          assert((NoAllocSection || !E.getTarget().isDefined() ||
-                  E.getTarget().getSection().getMemLifetime() !=
-                      orc::MemLifetime::NoAlloc) &&
-                 "Block in allocated section has edge pointing to no-alloc "
-                 "section");
+        Blocks.push_back(B);
+        NumEdges += B->edges_size();
+      }
 
-          // Dispatch to LinkerImpl for fixup.
-          if (auto Err = impl().applyFixup(G, *B, E))
+      // Fixups only write to the content of the block they belong to, so
+      // blocks can be fixed up concurrently. Only do so when there is enough
+      // work to amortize the cost of dispatching to the thread pool.
+      bool Parallel = NumEdges >= ParallelFixupThreshold;
+      // Keep the per-block debug output in order.
+      LLVM_DEBUG(Parallel = false);
+      if (!Parallel) {
+        for (auto *B : Blocks)
+          if (auto Err = fixUpBlock(G, *B, NoAllocSection))
             return Err;
-        }
+        continue;
       }
+
+      // Record an error per block so that, as in the serial case, the error
+      // of the first failing block is returned regardless of scheduling.
+      std::vector<Error> Errs;
+      Errs.reserve(Blocks.size());
+      for (size_t I = 0, E = Blocks.size(); I != E; ++I)
+        Errs.push_back(Error::success());
+      parallelFor(0, Blocks.size(), [&](size_t I) {
+        ErrorAsOutParameter _(Errs[I]);
+        Errs[I] = fixUpBlock(G, *Blocks[I], NoAllocSection);
+      });
+      Error Err = Error::success();
+      for (auto &E : Errs) {
+        if (Err)
+          consumeError(std::move(E));
+        else
+          Err = std::move(E);
+      }
+      if (Err)
+        return Err;
     }
 
     return Error::success();
   }
+
+  Error fixUpBlock(LinkGraph &G, Block &B, bool NoAllocSection) const {
+    LLVM_DEBUG(dbgs() << "  " << B << ":\n");
+    LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
+    (void)NoAllocSection;
+    for (auto &E : B.edges()) {
+
+      // Skip non-relocation edges.
+      if (!E.isRelocation())
+        continue;
+
+      // If B is a block in a Standard or Finalize section then make sure
+      // that no edges point to symbols in NoAlloc sections.
+      assert((NoAllocSection || !E.getTarget().isDefined() ||
+              E.getTarget().getSection().getMemLifetime() !=
+                  orc::MemLifetime::NoAlloc) &&
+             "Block in allocated section has edge pointing to no-alloc "
+             "section");
+
+      // Dispatch to LinkerImpl for fixup.
+      if (auto Err = impl().applyFixup(G, B, E))
+        return Err;
+    }
+    return Error::success();
+  }
 };
 
 /// Removes dead symbols/blocks/addressables.
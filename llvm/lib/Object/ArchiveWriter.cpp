@@ -12,6 +12,7 @@
 
 #include "llvm/Object/ArchiveWriter.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/BinaryFormat/Magic.h"
@@ -31,12 +32,14 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <cerrno>
 #include <map>
+#include <optional>
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
 #include <unistd.h>
@@ -733,10 +736,27 @@ bool isImportDescriptor(StringRef Name) {
           Name.ends_with(NullThunkDataSuffix));
 }
 
-static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
-                                                  uint16_t Index,
-                                                  raw_ostream &SymNames,
-                                                  SymMap *SymMap) {
+// Returns the names of the symbols of \p Obj that go into the archive symbol
+// table, in symbol table order.
+static Expected<std::vector<std::string>>
+getArchiveSymbolNames(SymbolicFile &Obj) {
+  std::vector<std::string> Names;
+  for (const object::BasicSymbolRef &S : Obj.symbols()) {
+    if (!isArchiveSymbol(S))
+      continue;
+    std::string Name;
+    raw_string_ostream NameStream(Name);
+    if (Error E = S.printName(NameStream))
+      return std::move(E);
+    Names.push_back(std::move(Name));
+  }
+  return std::move(Names);
+}
+
+static std::vector<unsigned> getSymbols(SymbolicFile *Obj,
+                                        ArrayRef<std::string> SymbolNames,
+                                        uint16_t Index, raw_ostream &SymNames,
+                                        SymMap *SymMap) {
   std::vector<unsigned> Ret;
 
   if (Obj == nullptr)
@@ -746,14 +766,8 @@ static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
   if (SymMap)
     Map = SymMap->UseECMap && isECObject(*Obj) ? &SymMap->ECMap : &SymMap->Map;
 
-  for (const object::BasicSymbolRef &S : Obj->symbols()) {
-    if (!isArchiveSymbol(S))
-      continue;
+  for (const std::string &Name : SymbolNames) {
     if (Map) {
-      std::string Name;
-      raw_string_ostream NameStream(Name);
-      if (Error E = S.printName(NameStream))
-        return std::move(E);
       if (!Map->try_emplace(Name, Index).second)
         continue; // ignore duplicated symbol
       if (Map == &SymMap->Map) {
@@ -766,9 +780,7 @@ static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
       }
     } else {
       Ret.push_back(SymNames.tell());
-      if (Error E = S.printName(SymNames))
-        return std::move(E);
-      SymNames << '\0';
+      SymNames << Name << '\0';
     }
   }
   return Ret;
@@ -844,17 +856,60 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
   }
 
   std::vector<std::unique_ptr<SymbolicFile>> SymFiles;
+  std::vector<std::vector<std::string>> SymbolNames;
 
   if (NeedSymbols != SymtabWritingMode::NoSymtab || isAIXBigArchive(Kind)) {
-    for (const NewArchiveMember &M : NewMembers) {
+    bool NeedNames = NeedSymbols != SymtabWritingMode::NoSymtab;
+    SymFiles.resize(NewMembers.size());
+    SymbolNames.resize(NewMembers.size());
+    std::vector<std::optional<Error>> Errs(NewMembers.size());
+    auto ConsumeErrs = make_scope_exit([&] {
+      for (std::optional<Error> &Err : Errs)
+        if (Err)
+          consumeError(std::move(*Err));
+    });
+
+    auto ReadMember = [&](size_t I) {
+      const NewArchiveMember &M = NewMembers[I];
       Expected<std::unique_ptr<SymbolicFile>> SymFileOrErr = getSymbolicFile(
           M.Buf->getMemBufferRef(), Context, Kind, [&](Error Err) {
             Warn(createFileError(M.MemberName, std::move(Err)));
           });
-      if (!SymFileOrErr)
-        return createFileError(M.MemberName, SymFileOrErr.takeError());
-      SymFiles.push_back(std::move(*SymFileOrErr));
-    }
+      if (!SymFileOrErr) {
+        Errs[I] = SymFileOrErr.takeError();
+        return;
+      }
+      SymFiles[I] = std::move(*SymFileOrErr);
+      if (!NeedNames || !SymFiles[I])
+        return;
+      Expected<std::vector<std::string>> NamesOrErr =
+          getArchiveSymbolNames(*SymFiles[I]);
+      if (!NamesOrErr) {
+        Errs[I] = NamesOrErr.takeError();
+        return;
+      }
+      SymbolNames[I] = std::move(*NamesOrErr);
+    };
+
+    // Reading the symbol tables of many members dominates the time to write
+    // large archives and is independent for each member, so do it in
+    // parallel. Bitcode members are read into the shared LLVMContext, which is
+    // not thread safe, so they are read afterwards on this thread.
+    std::vector<bool> IsBitcode(NewMembers.size());
+    for (size_t I = 0, E = NewMembers.size(); I != E; ++I)
+      IsBitcode[I] = identify_magic(NewMembers[I].Buf->getBuffer()) ==
+                     file_magic::bitcode;
+    parallelFor(0, NewMembers.size(), [&](size_t I) {
+      if (!IsBitcode[I])
+        ReadMember(I);
+    });
+    for (size_t I = 0, E = NewMembers.size(); I != E; ++I)
+      if (IsBitcode[I])
+        ReadMember(I);
+
+    for (size_t I = 0, E = NewMembers.size(); I != E; ++I)
+      if (Errs[I])
+        return createFileError(NewMembers[I].MemberName, std::move(*Errs[I]));
   }
 
   if (SymMap) {
@@ -963,11 +1018,9 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
 
     std::vector<unsigned> Symbols;
     if (NeedSymbols != SymtabWritingMode::NoSymtab) {
-      Expected<std::vector<unsigned>> SymbolsOrErr =
-          getSymbols(CurSymFile.get(), Index + 1, SymNames, SymMap);
-      if (!SymbolsOrErr)
-        return createFileError(M->MemberName, SymbolsOrErr.takeError());
-      Symbols = std::move(*SymbolsOrErr);
+      Symbols = getSymbols(CurSymFile.get(), SymbolNames[Index], Index + 1,
+                           SymNames, SymMap);
+      SymbolNames[Index].clear();
       if (CurSymFile)
         HasObject = true;
     }
@@ -1194,12 +1247,16 @@ Error writeArchiveToStream(raw_ostream &Out,
     if (ShouldWriteSymtab && NumSyms)
       // Generate the symbol names for the members.
       for (const auto &M : Data) {
-        Expected<std::vector<unsigned>> SymbolsOrErr = getSymbols(
-            M.SymFile.get(), 0,
-            is64BitSymbolicFile(M.SymFile.get()) ? SymNames64 : SymNames32,
-            nullptr);
-        if (!SymbolsOrErr)
-          return SymbolsOrErr.takeError();
+        if (!M.SymFile)
+          continue;
+        Expected<std::vector<std::string>> NamesOrErr =
+            getArchiveSymbolNames(*M.SymFile);
+        if (!NamesOrErr)
+          return NamesOrErr.takeError();
+        getSymbols(M.SymFile.get(), *NamesOrErr, 0,
+                   is64BitSymbolicFile(M.SymFile.get()) ? SymNames64
+                                                        : SymNames32,
+                   nullptr);
       }
 
     uint64_t MemberTableEndOffset =
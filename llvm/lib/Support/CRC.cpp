@@ -22,12 +22,13 @@
 
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/Config/config.h"
+#include "llvm/Support/Endian.h"
 
 using namespace llvm;
 
 #if !LLVM_ENABLE_ZLIB
 
-static const uint32_t CRCTable[256] = {
+static constexpr uint32_t CRCTable[256] = {
     0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f,
     0xe963a535, 0x9e6495a3, 0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988,
     0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91, 0x1db71064, 0x6ab020f2,
@@ -72,8 +73,36 @@ static const uint32_t CRCTable[256] = {
     0x54de5729, 0x23d967bf, 0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94,
     0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d};
 
+namespace {
+// Tables for the "slicing-by-8" algorithm: Table[N][B] is the CRC of byte B
+// followed by N zero bytes, which lets us process 8 bytes per iteration with
+// independent table lookups.
+struct SlicingTables {
+  uint32_t Table[8][256] = {};
+  constexpr SlicingTables() {
+    for (int I = 0; I != 256; ++I)
+      Table[0][I] = CRCTable[I];
+    for (int N = 1; N != 8; ++N)
+      for (int I = 0; I != 256; ++I)
+        Table[N][I] =
+            (Table[N - 1][I] >> 8) ^ CRCTable[Table[N - 1][I] & 0xff];
+  }
+};
+} // namespace
+
+static constexpr SlicingTables Slicing;
+
 uint32_t llvm::crc32(uint32_t CRC, ArrayRef<uint8_t> Data) {
   CRC ^= 0xFFFFFFFFU;
+  const auto &T = Slicing.Table;
+  while (Data.size() >= 8) {
+    uint32_t Lo = CRC ^ support::endian::read32le(Data.data());
+    uint32_t Hi = support::endian::read32le(Data.data() + 4);
+    CRC = T[7][Lo & 0xff] ^ T[6][(Lo >> 8) & 0xff] ^ T[5][(Lo >> 16) & 0xff] ^
+          T[4][Lo >> 24] ^ T[3][Hi & 0xff] ^ T[2][(Hi >> 8) & 0xff] ^
+          T[1][(Hi >> 16) & 0xff] ^ T[0][Hi >> 24];
+    Data = Data.drop_front(8);
+  }
   for (uint8_t Byte : Data) {
     int TableIdx = (CRC ^ Byte) & 0xff;
     CRC = CRCTable[TableIdx] ^ (CRC >> 8);
@@ -73,12 +73,14 @@ private:
 
 // A FileOutputBuffer which keeps data in memory and writes to the final
 // output file on commit(). This is used only when we cannot use OnDiskBuffer.
+// If UseTempFile is true, the data is written to a temporary file which then
+// atomically replaces the final output file, as with OnDiskBuffer.
 class InMemoryBuffer : public FileOutputBuffer {
 public:
   InMemoryBuffer(StringRef Path, MemoryBlock Buf, std::size_t BufSize,
-                 unsigned Mode)
-      : FileOutputBuffer(Path), Buffer(Buf), BufferSize(BufSize),
-        Mode(Mode) {}
+                 unsigned Mode, bool UseTempFile)
+      : FileOutputBuffer(Path), Buffer(Buf), BufferSize(BufSize), Mode(Mode),
+        UseTempFile(UseTempFile) {}
 
   uint8_t *getBufferStart() const override { return (uint8_t *)Buffer.base(); }
 
@@ -96,6 +98,9 @@ public:
     }
 
     using namespace sys::fs;
+    if (UseTempFile)
+      return commitToTempFile();
+
     int FD;
     std::error_code EC;
     if (auto EC =
@@ -107,21 +112,47 @@ public:
   }
 
 private:
+  // Write the buffer with plain write(2) calls to a temporary file next to the
+  // final output and rename it into place. Readers never observe a partially
+  // written file, and the old file is not truncated in place, which is slow on
+  // network filesystems.
+  Error commitToTempFile() {
+    llvm::TimeTraceScope timeScope("Commit buffer to disk");
+    Expected<fs::TempFile> FileOrErr =
+        fs::TempFile::create(FinalPath + ".tmp%%%%%%%", Mode);
+    if (!FileOrErr)
+      return FileOrErr.takeError();
+    fs::TempFile File = std::move(*FileOrErr);
+    {
+      raw_fd_ostream OS(File.FD, /*shouldClose=*/false, /*unbuffered=*/true);
+      OS << StringRef((const char *)Buffer.base(), BufferSize);
+      if (OS.has_error()) {
+        std::error_code EC = OS.error();
+        OS.clear_error();
+        consumeError(File.discard());
+        return errorCodeToError(EC);
+      }
+    }
+    return File.keep(FinalPath);
+  }
+
   // Buffer may actually contain a larger memory block than BufferSize
   OwningMemoryBlock Buffer;
   size_t BufferSize;
   unsigned Mode;
+  bool UseTempFile;
 };
 } // namespace
 
 static Expected<std::unique_ptr<InMemoryBuffer>>
-createInMemoryBuffer(StringRef Path, size_t Size, unsigned Mode) {
+createInMemoryBuffer(StringRef Path, size_t Size, unsigned Mode,
+                     bool UseTempFile = false) {
   std::error_code EC;
   MemoryBlock MB = Memory::allocateMappedMemory(
       Size, nullptr, sys::Memory::MF_READ | sys::Memory::MF_WRITE, EC);
   if (EC)
     return errorCodeToError(EC);
-  return std::make_unique<InMemoryBuffer>(Path, MB, Size, Mode);
+  return std::make_unique<InMemoryBuffer>(Path, MB, Size, Mode, UseTempFile);
 }
 
 static Expected<std::unique_ptr<FileOutputBuffer>>
@@ -147,7 +178,7 @@ createOnDiskBuffer(StringRef Path, size_t Size, unsigned Mode) {
   // If that happens, we fall back to in-memory buffer as the last resort.
   if (EC) {
     consumeError(File.discard());
-    return createInMemoryBuffer(Path, Size, Mode);
+    return createInMemoryBuffer(Path, Size, Mode, /*UseTempFile=*/true);
   }
 
   return std::make_unique<OnDiskBuffer>(Path, std::move(File),
@@ -187,7 +218,7 @@ FileOutputBuffer::create(StringRef Path, size_t Size, unsigned Flags) {
   case fs::file_type::file_not_found:
   case fs::file_type::status_error:
     if (Flags & F_no_mmap)
-      return createInMemoryBuffer(Path, Size, Mode);
+      return createInMemoryBuffer(Path, Size, Mode, /*UseTempFile=*/true);
     else
       return createOnDiskBuffer(Path, Size, Mode);
   default:
@@ -38,6 +38,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/JSON.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/raw_ostream.h"
@@ -1237,14 +1238,23 @@ void llvm::ComputeCrossModuleImport(
   // imported to the export list. We also need to mark any references and calls
   // they make as exported as well. We do this here, as it is more efficient
   // since we may import the same values multiple times into different modules
-  // during the import computation.
-  for (auto &ELI : ExportLists) {
+  // during the import computation. Each export list only depends on the index
+  // and its own module, so the lists are processed in parallel.
+  SmallVector<std::pair<StringRef, FunctionImporter::ExportSetTy *>, 0> ELIs;
+  ELIs.reserve(ExportLists.size());
+  for (auto &ELI : ExportLists)
+    ELIs.emplace_back(ELI.first, &ELI.second);
+  const GVSummaryMapTy NoDefinedGVSummaries;
+  parallelForEach(ELIs, [&](auto &ELI) {
+    FunctionImporter::ExportSetTy &Exports = *ELI.second;
     // `NewExports` tracks the VI that gets exported because the full definition
     // of its user/referencer gets exported.
     FunctionImporter::ExportSetTy NewExports;
-    const auto &DefinedGVSummaries =
-        ModuleToDefinedGVSummaries.lookup(ELI.first);
-    for (auto &EI : ELI.second) {
+    auto DefinedIt = ModuleToDefinedGVSummaries.find(ELI.first);
+    const GVSummaryMapTy &DefinedGVSummaries =
+        DefinedIt != ModuleToDefinedGVSummaries.end() ? DefinedIt->second
+                                                      : NoDefinedGVSummaries;
+    for (auto &EI : Exports) {
       // Find the copy defined in the exporting module so that we can mark the
       // values it references in that specific definition as exported.
       // Below we will add all references and called values, without regard to
@@ -1280,8 +1290,8 @@ void llvm::ComputeCrossModuleImport(
       else
         ++EI;
     }
-    ELI.second.insert_range(NewExports);
-  }
+    Exports.insert_range(NewExports);
+  });
 
   assert(checkVariableImport(Index, ImportLists, ExportLists));
 #ifndef NDEBUG
@@ -26,17 +26,21 @@
 #include "llvm/IR/GlobalObject.h"
 #include "llvm/IR/GlobalValue.h"
 #include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Instruction.h"
+#include "llvm/IR/Instructions.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/User.h"
 #include "llvm/IR/Value.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MD5.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 #include "llvm/Transforms/Utils/ValueMapper.h"
+#include <algorithm>
 #include <cassert>
 #include <iterator>
 #include <memory>
@@ -48,6 +52,12 @@ using namespace llvm;
 
 #define DEBUG_TYPE "split-module"
 
+static cl::opt<bool> ClusterCalls(
+    "split-module-cluster-calls", cl::Hidden, cl::init(false),
+    cl::desc("Keep functions in the same partition as their direct callees, "
+             "as long as a cluster does not exceed the size of a partition, "
+             "and balance partitions by instruction count"));
+
 namespace {
 
 using ClusterMapType = EquivalenceClasses<const GlobalValue *>;
@@ -107,6 +117,75 @@ static const GlobalObject *getGVPartitioningRoot(const GlobalValue *GV) {
   return GO;
 }
 
+// The cost of a global value when balancing partitions by size.
+static unsigned getGVWeight(const GlobalValue *GV) {
+  if (const auto *F = dyn_cast<Function>(GV))
+    return std::max(F->getInstructionCount(), 1u);
+  return 1;
+}
+
+// Merges the clusters of functions and their direct callees, so that call
+// chains end up in the same partition. Clusters are not merged beyond the size
+// of a single partition, which keeps the partitions balanced. Functions are
+// visited in module order, so the result is deterministic.
+static void clusterCallGraph(Module &M, ClusterMapType &GVtoClusterMap,
+                             unsigned N) {
+  // Functions whose partition is decided by name (comdat members that are not
+  // already clustered, and ifunc resolvers) must not be moved by clustering.
+  SmallPtrSet<const Function *, 8> Pinned;
+  for (const GlobalIFunc &GIF : M.ifuncs())
+    if (const Function *Resolver = GIF.getResolverFunction())
+      Pinned.insert(Resolver);
+  auto canCluster = [&](const Function *F) {
+    return F && !F->isDeclaration() && !Pinned.count(F) &&
+           (!F->hasComdat() || GVtoClusterMap.contains(F));
+  };
+
+  uint64_t TotalWeight = 0;
+  for (const Function &F : M)
+    if (!F.isDeclaration())
+      TotalWeight += getGVWeight(&F);
+  const uint64_t MaxClusterWeight = TotalWeight / N + 1;
+
+  // Weight of each cluster, keyed by its leader.
+  DenseMap<const GlobalValue *, uint64_t> ClusterWeights;
+  for (const auto &C : GVtoClusterMap)
+    ClusterWeights[GVtoClusterMap.getLeaderValue(C->getData())] +=
+        getGVWeight(C->getData());
+  auto getLeader = [&](const Function *F) {
+    if (!GVtoClusterMap.contains(F)) {
+      GVtoClusterMap.insert(F);
+      ClusterWeights[F] = getGVWeight(F);
+    }
+    return GVtoClusterMap.getLeaderValue(F);
+  };
+
+  for (const Function &F : M) {
+    if (!canCluster(&F))
+      continue;
+    for (const Instruction &I : instructions(F)) {
+      const auto *CB = dyn_cast<CallBase>(&I);
+      if (!CB)
+        continue;
+      const Function *Callee = CB->getCalledFunction();
+      if (Callee == &F || !canCluster(Callee))
+        continue;
+      const GlobalValue *CallerLeader = getLeader(&F);
+      const GlobalValue *CalleeLeader = getLeader(Callee);
+      if (CallerLeader == CalleeLeader)
+        continue;
+      uint64_t Weight =
+          ClusterWeights[CallerLeader] + ClusterWeights[CalleeLeader];
+      if (Weight > MaxClusterWeight)
+        continue;
+      ClusterWeights.erase(CallerLeader);
+      ClusterWeights.erase(CalleeLeader);
+      ClusterWeights[*GVtoClusterMap.unionSets(CallerLeader, CalleeLeader)] =
+          Weight;
+    }
+  }
+}
+
 // Find partitions for module in the way that no locals need to be
 // globalized.
 // Try to balance pack those partitions into N files since this roughly equals
@@ -163,6 +242,9 @@ static void findPartitions(Module &M, ClusterIDMapType &ClusterIDMap,
   llvm::for_each(M.globals(), recordGVSet);
   llvm::for_each(M.aliases(), recordGVSet);
 
+  if (ClusterCalls)
+    clusterCallGraph(M, GVtoClusterMap, N);
+
   // Assigned all GVs to merged clusters while balancing number of objects in
   // each.
   BalancingQueueType BalancingQueue(compareClusters);
@@ -172,22 +254,38 @@ static void findPartitions(Module &M, ClusterIDMapType &ClusterIDMap,
 
   SmallPtrSet<const GlobalValue *, 32> Visited;
 
-  // To guarantee determinism, we have to sort SCC according to size.
-  // When size is the same, use leader's name.
+  // Clusters are visited in the order they were created, which only depends on
+  // the module. With -split-module-cluster-calls, partitions are balanced by
+  // weight, which works best when the largest clusters are placed first, so
+  // sort clusters by weight and use the leader's name to break ties.
+  SmallVector<std::pair<const GlobalValue *, uint64_t>, 0> Clusters;
   for (const auto &C : GVtoClusterMap) {
     if (!C->isLeader())
       continue;
-
+    uint64_t Weight = 0;
+    if (ClusterCalls)
+      for (const GlobalValue *GV : GVtoClusterMap.members(*C))
+        Weight += getGVWeight(GV);
+    Clusters.push_back({C->getData(), Weight});
+  }
+  if (ClusterCalls)
+    llvm::stable_sort(Clusters, [](const auto &A, const auto &B) {
+      if (A.second != B.second)
+        return A.second > B.second;
+      return A.first->getName() < B.first->getName();
+    });
+
+  for (const auto &[Leader, Weight] : Clusters) {
     unsigned CurrentClusterID = BalancingQueue.top().first;
     unsigned CurrentClusterSize = BalancingQueue.top().second;
     BalancingQueue.pop();
 
     LLVM_DEBUG(dbgs() << "Root[" << CurrentClusterID << "] cluster_size("
-                      << std::distance(GVtoClusterMap.member_begin(*C),
+                      << std::distance(GVtoClusterMap.findLeader(Leader),
                                        GVtoClusterMap.member_end())
-                      << ") ----> " << C->getData()->getName() << "\n");
+                      << ") ----> " << Leader->getName() << "\n");
 
-    for (ClusterMapType::member_iterator MI = GVtoClusterMap.findLeader(*C);
+    for (ClusterMapType::member_iterator MI = GVtoClusterMap.findLeader(Leader);
          MI != GVtoClusterMap.member_end(); ++MI) {
       if (!Visited.insert(*MI).second)
         continue;
@@ -195,7 +293,7 @@ static void findPartitions(Module &M, ClusterIDMapType &ClusterIDMap,
                         << ((*MI)->hasLocalLinkage() ? " l " : " e ") << "\n");
       Visited.insert(*MI);
       ClusterIDMap[*MI] = CurrentClusterID;
-      CurrentClusterSize++;
+      CurrentClusterSize += ClusterCalls ? getGVWeight(*MI) : 1;
     }
     // Add this set size to the number of entries in this cluster.
     BalancingQueue.push(std::make_pair(CurrentClusterID, CurrentClusterSize));
@@ -134,6 +134,7 @@
 #include "llvm/Support/InstructionCost.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/NativeFormatting.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include "llvm/Transforms/Utils/InjectTLIMappings.h"
@@ -7359,6 +7360,7 @@ LoopVectorizationPlanner::planInVPlanNativePath(ElementCount UserVF) {
 
 void LoopVectorizationPlanner::plan(ElementCount UserVF, unsigned UserIC) {
   assert(OrigLoop->isInnermost() && "Inner loop expected.");
+  TimeTraceScope TimeScope("LoopVectorizePlan");
   CM.collectValuesToIgnore();
   CM.collectElementTypesForWidening();
 
@@ -7727,6 +7729,7 @@ static bool planContainsAdditionalSimplifications(VPlan &Plan,
 VectorizationFactor LoopVectorizationPlanner::computeBestVF() {
   if (VPlans.empty())
     return VectorizationFactor::Disabled();
+  TimeTraceScope TimeScope("LoopVectorizeSelectVF");
   // If there is a single VPlan with a single VF, return it directly.
   VPlan &FirstPlan = *VPlans[0];
   if (VPlans.size() == 1 && size(FirstPlan.vectorFactors()) == 1)
@@ -10804,6 +10807,10 @@ static Value *createInductionAdditionalBypassValues(
 bool LoopVectorizePass::processLoop(Loop *L) {
   assert((EnableVPlanNativePath || L->isInnermost()) &&
          "VPlan-native path is not enabled. Only process inner loops.");
+  TimeTraceScope TimeScope("LoopVectorizeLoop", [&]() {
+    return (L->getHeader()->getParent()->getName() + " " + L->getLocStr())
+        .str();
+  });
 
   LLVM_DEBUG(dbgs() << "\nLV: Checking a loop in '"
                     << L->getHeader()->getParent()->getName() << "' from "
@@ -0,0 +1,50 @@
+; A caller and its callee are not merged when the cluster would be larger than
+; 1/N of the module. Clusters of the same weight are placed by leader name.
+; RUN: llvm-split -j2 -split-module-cluster-calls -o %t %s
+; RUN: llvm-dis -o - %t0 | FileCheck --check-prefix=CHECK0 %s
+; RUN: llvm-dis -o - %t1 | FileCheck --check-prefix=CHECK1 %s
+
+; CHECK0: define i32 @big1(
+; CHECK0: declare i32 @big2(
+; CHECK0: define void @small()
+; CHECK0: define void @tiny()
+
+; CHECK1: declare i32 @big1(
+; CHECK1: define i32 @big2(
+; CHECK1: declare void @small()
+; CHECK1: declare void @tiny()
+
+define i32 @big1(i32 %x) {
+  %1 = add i32 %x, 1
+  %2 = add i32 %1, 2
+  %3 = add i32 %2, 3
+  %4 = add i32 %3, 4
+  %5 = add i32 %4, 5
+  %6 = add i32 %5, 6
+  %7 = add i32 %6, 7
+  %8 = add i32 %7, 8
+  %r = call i32 @big2(i32 %8)
+  ret i32 %r
+}
+
+define i32 @big2(i32 %x) {
+  %1 = add i32 %x, 1
+  %2 = add i32 %1, 2
+  %3 = add i32 %2, 3
+  %4 = add i32 %3, 4
+  %5 = add i32 %4, 5
+  %6 = add i32 %5, 6
+  %7 = add i32 %6, 7
+  %8 = add i32 %7, 8
+  %9 = add i32 %8, 9
+  ret i32 %9
+}
+
+define void @small() {
+  call void @tiny()
+  ret void
+}
+
+define void @tiny() {
+  ret void
+}
@@ -0,0 +1,43 @@
+; A function in a single-member comdat stays where its comdat name places it,
+; while a comdat group that is already clustered is moved with its caller as a
+; whole.
+; RUN: llvm-split -j2 -split-module-cluster-calls -o %t %s
+; RUN: llvm-dis -o - %t0 | FileCheck --check-prefix=CHECK0 %s
+; RUN: llvm-dis -o - %t1 | FileCheck --check-prefix=CHECK1 %s
+
+; CHECK0-NOT: define linkonce_odr void @inl()
+; CHECK0: define linkonce_odr void @g1() comdat($grp)
+; CHECK0: define linkonce_odr void @g2() comdat($grp)
+; CHECK0: define void @use_inl()
+; CHECK0: define void @use_grp()
+
+; CHECK1: define linkonce_odr void @inl() comdat
+; CHECK1-NOT: define linkonce_odr void @g1()
+; CHECK1-NOT: define linkonce_odr void @g2()
+; CHECK1-NOT: define void @use_inl()
+; CHECK1-NOT: define void @use_grp()
+
+$inl = comdat any
+$grp = comdat any
+
+define linkonce_odr void @inl() comdat {
+  ret void
+}
+
+define linkonce_odr void @g1() comdat($grp) {
+  ret void
+}
+
+define linkonce_odr void @g2() comdat($grp) {
+  ret void
+}
+
+define void @use_inl() {
+  call void @inl()
+  ret void
+}
+
+define void @use_grp() {
+  call void @g1()
+  ret void
+}
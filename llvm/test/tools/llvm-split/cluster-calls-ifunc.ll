@@ -0,0 +1,28 @@
+; An ifunc resolver stays with its ifunc and is not moved to the partition of
+; a function that calls it directly.
+; RUN: llvm-split -j2 -split-module-cluster-calls -o %t %s
+; RUN: llvm-dis -o - %t0 | FileCheck --check-prefix=CHECK0 %s
+; RUN: llvm-dis -o - %t1 | FileCheck --check-prefix=CHECK1 %s
+
+; CHECK0: @foo = ifunc void (), ptr @foo_resolver
+; CHECK0: define ptr @foo_resolver()
+; CHECK0-NOT: define void @call_resolver()
+
+; CHECK1-NOT: = ifunc
+; CHECK1-NOT: define ptr @foo_resolver()
+; CHECK1: define void @call_resolver()
+
+@foo = ifunc void (), ptr @foo_resolver
+
+define ptr @foo_resolver() {
+  ret ptr @foo_impl
+}
+
+define void @foo_impl() {
+  ret void
+}
+
+define void @call_resolver() {
+  %p = call ptr @foo_resolver()
+  ret void
+}
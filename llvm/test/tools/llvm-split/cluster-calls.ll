@@ -0,0 +1,48 @@
+; Callers and their direct callees are placed in the same partition, and the
+; largest cluster is placed first.
+; RUN: llvm-split -j2 -split-module-cluster-calls -o %t %s
+; RUN: llvm-dis -o - %t0 | FileCheck --check-prefix=CHECK0 %s
+; RUN: llvm-dis -o - %t1 | FileCheck --check-prefix=CHECK1 %s
+
+; The output does not depend on the run.
+; RUN: llvm-split -j2 -split-module-cluster-calls -o %t.again %s
+; RUN: cmp %t0 %t.again0
+; RUN: cmp %t1 %t.again1
+
+; CHECK0: declare void @a()
+; CHECK0: declare void @b()
+; CHECK0: declare void @c()
+; CHECK0: define i32 @d(
+; CHECK0: define i32 @e(
+
+; CHECK1: define void @a()
+; CHECK1: define void @b()
+; CHECK1: define void @c()
+; CHECK1: declare i32 @d(
+; CHECK1: declare i32 @e(
+
+define void @a() {
+  call void @b()
+  ret void
+}
+
+define void @b() {
+  call void @c()
+  ret void
+}
+
+define void @c() {
+  ret void
+}
+
+define i32 @d(i32 %x) {
+  %r = call i32 @e(i32 %x)
+  ret i32 %r
+}
+
+define i32 @e(i32 %x) {
+  %1 = add i32 %x, 1
+  %2 = mul i32 %1, 3
+  %3 = xor i32 %2, 5
+  ret i32 %3
+}
@@ -80,7 +80,11 @@ static cl::opt<CountBy> CountByOpt(
                    "exists."),
         clEnumValN(CountBy::ARGUMENT, "arg",
                    "Counts based on the value each specified argument has. The "
-                   "argument has to have a number value to be considered.")),
+                   "argument has to have a number value to be considered."),
+        clEnumValN(CountBy::HOTNESS, "hotness",
+                   "Sums the hotness of the remarks instead of counting them. "
+                   "Remarks without profile hotness information add nothing "
+                   "to the sum.")),
     cl::init(CountBy::REMARK), cl::sub(CountSub));
 static cl::opt<GroupBy> GroupByOpt(
     "group-by", cl::desc("Specify the property to group remarks by."),
@@ -95,6 +99,11 @@ static cl::opt<GroupBy> GroupByOpt(
             GroupBy::PER_FUNCTION_WITH_DEBUG_LOC, "function-with-loc",
             "Breakdown the count by function name taking into consideration "
             "the filepath info from the DebugLoc of the remark."),
+        clEnumValN(GroupBy::PER_PASS, "pass",
+                   "Breakdown the count by the name of the pass that emitted "
+                   "the remark."),
+        clEnumValN(GroupBy::PER_REMARK_NAME, "remark-name",
+                   "Breakdown the count by remark name."),
         clEnumValN(GroupBy::TOTAL, "total",
                    "Output the total number corresponding to the count for the "
                    "provided input file.")),
@@ -171,6 +180,10 @@ std::optional<std::string> Counter::getGroupByKey(const Remark &Remark) {
     return Remark.FunctionName.str();
   case GroupBy::TOTAL:
     return "Total";
+  case GroupBy::PER_PASS:
+    return Remark.PassName.str();
+  case GroupBy::PER_REMARK_NAME:
+    return Remark.RemarkName.str();
   case GroupBy::PER_SOURCE:
   case GroupBy::PER_FUNCTION_WITH_DEBUG_LOC:
     if (!Remark.Loc.has_value())
@@ -198,8 +211,13 @@ void ArgumentCounter::collect(const Remark &Remark) {
 }
 
 void RemarkCounter::collect(const Remark &Remark) {
-  if (std::optional<std::string> Key = getGroupByKey(Remark))
+  std::optional<std::string> Key = getGroupByKey(Remark);
+  if (!Key)
+    return;
+  if (!SumHotness)
     ++CountedByRemarksMap[*Key];
+  else
+    CountedByRemarksMap[*Key] += Remark.Hotness.value_or(0);
 }
 
 Error ArgumentCounter::print(StringRef OutputFileName) {
@@ -240,7 +258,7 @@ Error RemarkCounter::print(StringRef OutputFileName) {
 
   auto OF = std::move(*MaybeOF);
   OF->os() << groupByToStr(Group) << ","
-           << "Count\n";
+           << (SumHotness ? "Hotness\n" : "Count\n");
   for (auto [Key, Count] : CountedByRemarksMap)
     OF->os() << Key << "," << Count << "\n";
   OF->keep();
@@ -305,8 +323,8 @@ static Error collectRemarks() {
   if (!MaybeFilter)
     return MaybeFilter.takeError();
   auto &Filter = *MaybeFilter;
-  if (CountByOpt == CountBy::REMARK) {
-    RemarkCounter RC(GroupByOpt);
+  if (CountByOpt == CountBy::REMARK || CountByOpt == CountBy::HOTNESS) {
+    RemarkCounter RC(GroupByOpt, CountByOpt == CountBy::HOTNESS);
     if (auto E = useCollectRemark(Buffer, RC, Filter))
       return E;
   } else if (CountByOpt == CountBy::ARGUMENT) {
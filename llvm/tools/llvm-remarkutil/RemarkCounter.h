@@ -20,7 +20,7 @@ namespace remarks {
 
 /// Collect remarks by counting the existance of a remark or by looking through
 /// the keys and summing through the total count.
-enum class CountBy { REMARK, ARGUMENT };
+enum class CountBy { REMARK, ARGUMENT, HOTNESS };
 
 /// Summarize the count by either emitting one count for the remark file, or
 /// grouping the count by source file or by function name.
@@ -28,7 +28,9 @@ enum class GroupBy {
   TOTAL,
   PER_SOURCE,
   PER_FUNCTION,
-  PER_FUNCTION_WITH_DEBUG_LOC
+  PER_FUNCTION_WITH_DEBUG_LOC,
+  PER_PASS,
+  PER_REMARK_NAME
 };
 
 /// Convert \p GroupBy to a std::string.
@@ -42,6 +44,10 @@ inline std::string groupByToStr(GroupBy GroupBy) {
     return "FuctionWithDebugLoc";
   case GroupBy::PER_SOURCE:
     return "Source";
+  case GroupBy::PER_PASS:
+    return "Pass";
+  case GroupBy::PER_REMARK_NAME:
+    return "RemarkName";
   }
 }
 
@@ -196,8 +202,12 @@ private:
 /// by reporting count for functions, source or total count for the provided
 /// remark file.
 struct RemarkCounter : Counter {
-  std::map<std::string, unsigned> CountedByRemarksMap;
-  RemarkCounter(GroupBy Group) : Counter(Group) {}
+  std::map<std::string, uint64_t> CountedByRemarksMap;
+  /// Sum the hotness of the remarks instead of counting them. Remarks without
+  /// hotness information don't contribute to the sum.
+  bool SumHotness = false;
+  RemarkCounter(GroupBy Group, bool SumHotness = false)
+      : Counter(Group), SumHotness(SumHotness) {}
 
   /// Advance the internal map count broken by \p Group when
   /// seeing \p Remark.
@@ -206,7 +216,7 @@ struct RemarkCounter : Counter {
   /// Print a CSV table consisting of an index which is specified by \p
   /// `Group` and can be a function name, source file name or function name
   /// with the full source path and a counts column corresponding to the count
-  /// of each individual remark at th index.
+  /// (or the total hotness) of each individual remark at th index.
   Error print(StringRef OutputFileName) override;
 };
 } // namespace remarks
@@ -0,0 +1,317 @@
+//===- llvm-time-trace-aggregate.cpp --------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// llvm-time-trace-aggregate combines the JSON files written by -ftime-trace
+// (see llvm/Support/TimeProfiler.h) for many translation units into a single
+// profile of the whole build.
+//
+// In the default "table" format every event is keyed by its name and detail
+// (e.g. "Source" plus the header path, or "InstantiateFunction" plus the
+// specialization) and the tool reports the total time, number of occurrences
+// and number of traces it appears in, sorted by total time. "Source" events
+// cover the whole time a header is being parsed, including nested includes,
+// which makes the table directly usable to find the headers that are most
+// expensive to parse across a build.
+//
+// The "folded" format reconstructs the nesting of the complete events of every
+// thread and prints one "frame;frame;frame self-time" line per unique stack,
+// which is the input format of common flame graph tools.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/WithColor.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <map>
+
+using namespace llvm;
+
+static cl::OptionCategory AggregateCategory("Aggregate Options");
+
+static cl::list<std::string> InputFilenames(cl::Positional, cl::OneOrMore,
+                                            cl::desc("<time-trace json files>"),
+                                            cl::cat(AggregateCategory));
+static cl::opt<std::string> OutputFilename("output", cl::value_desc("output"),
+                                           cl::init("-"),
+                                           cl::desc("Output file"),
+                                           cl::cat(AggregateCategory));
+static cl::alias OutputFilenameA("o", cl::aliasopt(OutputFilename),
+                                 cl::cat(AggregateCategory));
+
+enum class OutputFormat { Table, Folded };
+static cl::opt<OutputFormat> Format(
+    "format", cl::desc("Output format"), cl::init(OutputFormat::Table),
+    cl::values(clEnumValN(OutputFormat::Table, "table",
+                          "Events sorted by total time"),
+               clEnumValN(OutputFormat::Folded, "folded",
+                          "Folded stacks for flame graph tools")),
+    cl::cat(AggregateCategory));
+
+static cl::list<std::string>
+    EventNames("event", cl::desc("Only report events with this name"),
+               cl::value_desc("name"), cl::cat(AggregateCategory));
+
+static cl::opt<bool> IgnoreDetail(
+    "ignore-detail",
+    cl::desc("Aggregate events by name only, ignoring their detail"),
+    cl::cat(AggregateCategory));
+
+static cl::opt<unsigned> Top("top",
+                             cl::desc("Only print the N most expensive "
+                                      "entries of the table (0 = all)"),
+                             cl::init(0), cl::cat(AggregateCategory));
+
+static void exitWithError(Twine Message, StringRef Whence = "") {
+  WithColor::error();
+  if (!Whence.empty())
+    errs() << Whence << ": ";
+  errs() << Message << "\n";
+  ::exit(1);
+}
+
+namespace {
+struct Event {
+  StringRef Name;
+  StringRef Detail;
+  int64_t Ts = 0;
+  int64_t Dur = 0;
+};
+
+struct Total {
+  int64_t DurUs = 0;
+  uint64_t Count = 0;
+  uint64_t Traces = 0;
+  // Index of the last trace that contributed to this entry, used to count
+  // every trace only once.
+  size_t LastTrace = ~size_t(0);
+};
+} // namespace
+
+static bool isReported(StringRef Name) {
+  // The per-name totals emitted by the profiler itself would be counted twice.
+  if (Name.starts_with("Total "))
+    return false;
+  return EventNames.empty() || is_contained(EventNames, Name);
+}
+
+static std::string getKey(const Event &E) {
+  if (IgnoreDetail || E.Detail.empty())
+    return E.Name.str();
+  return (E.Name + " (" + E.Detail + ")").str();
+}
+
+// Frames of a folded stack are separated by ';', so keep it out of the frames.
+static std::string getFrame(const Event &E) {
+  std::string Frame = getKey(E);
+  std::replace(Frame.begin(), Frame.end(), ';', ',');
+  return Frame;
+}
+
+// Events of one thread of one trace file, keyed by (pid, tid).
+using ThreadEvents = std::map<std::pair<int64_t, int64_t>, std::vector<Event>>;
+
+// Pairs the begin ("b") and end ("e") markers of async events. The profiler
+// only uses them for properly nested scopes (e.g. "Source"), so a stack per
+// thread is enough. Begin markers are written in the order their scopes end,
+// so for markers with the same timestamp the later one is the outer scope.
+static void matchAsyncEvents(ThreadEvents &Begins, ThreadEvents &Ends,
+                             ThreadEvents &Complete) {
+  for (auto &[Thread, Bs] : Begins) {
+    std::vector<Event> &Es = Ends[Thread];
+    SmallVector<std::pair<size_t, bool>, 0> Markers;
+    for (size_t I = 0, N = Bs.size(); I != N; ++I)
+      Markers.push_back({I, true});
+    for (size_t I = 0, N = Es.size(); I != N; ++I)
+      Markers.push_back({I, false});
+    llvm::stable_sort(Markers, [&](auto A, auto B) {
+      int64_t TsA = A.second ? Bs[A.first].Ts : Es[A.first].Ts;
+      int64_t TsB = B.second ? Bs[B.first].Ts : Es[B.first].Ts;
+      if (TsA != TsB)
+        return TsA < TsB;
+      // Close scopes before opening new ones at the same timestamp.
+      if (A.second != B.second)
+        return !A.second;
+      return A.second && A.first > B.first;
+    });
+
+    SmallVector<size_t, 0> Stack;
+    for (auto [I, IsBegin] : Markers) {
+      if (IsBegin) {
+        Stack.push_back(I);
+        continue;
+      }
+      if (Stack.empty())
+        continue;
+      Event E = Bs[Stack.pop_back_val()];
+      E.Dur = Es[I].Ts - E.Ts;
+      Complete[Thread].push_back(E);
+    }
+  }
+}
+
+static void readTrace(StringRef Filename, size_t TraceIdx,
+                      StringMap<Total> &Totals, StringMap<int64_t> &Folded) {
+  auto BufOrErr = MemoryBuffer::getFileOrSTDIN(Filename, /*IsText=*/true);
+  if (!BufOrErr)
+    exitWithError(BufOrErr.getError().message(), Filename);
+  Expected<json::Value> Root = json::parse((*BufOrErr)->getBuffer());
+  if (!Root)
+    exitWithError(toString(Root.takeError()), Filename);
+  const json::Object *Obj = Root->getAsObject();
+  const json::Array *TraceEvents = Obj ? Obj->getArray("traceEvents") : nullptr;
+  if (!TraceEvents)
+    exitWithError("missing 'traceEvents' array", Filename);
+
+  ThreadEvents Complete, Begins, Ends;
+  for (const json::Value &V : *TraceEvents) {
+    const json::Object *EvObj = V.getAsObject();
+    if (!EvObj)
+      continue;
+    std::optional<StringRef> Ph = EvObj->getString("ph");
+    std::optional<StringRef> Name = EvObj->getString("name");
+    if (!Ph || !Name || !isReported(*Name))
+      continue;
+
+    Event E;
+    E.Name = *Name;
+    E.Ts = EvObj->getInteger("ts").value_or(0);
+    if (const json::Object *Args = EvObj->getObject("args"))
+      E.Detail = Args->getString("detail").value_or("");
+    auto Thread = std::make_pair(EvObj->getInteger("pid").value_or(0),
+                                 EvObj->getInteger("tid").value_or(0));
+    if (*Ph == "X") {
+      E.Dur = EvObj->getInteger("dur").value_or(0);
+      Complete[Thread].push_back(E);
+    } else if (*Ph == "b") {
+      Begins[Thread].push_back(E);
+    } else if (*Ph == "e") {
+      Ends[Thread].push_back(E);
+    }
+  }
+
+  if (Format == OutputFormat::Table) {
+    matchAsyncEvents(Begins, Ends, Complete);
+    for (auto &[Thread, Events] : Complete) {
+      for (const Event &E : Events) {
+        Total &T = Totals[getKey(E)];
+        T.DurUs += E.Dur;
+        ++T.Count;
+        if (T.LastTrace != TraceIdx) {
+          T.LastTrace = TraceIdx;
+          ++T.Traces;
+        }
+      }
+    }
+    return;
+  }
+
+  // Async events live on their own tracks, so only the complete events form
+  // the call stacks of a thread.
+  for (auto &[Thread, Events] : Complete) {
+    llvm::stable_sort(Events, [](const Event &A, const Event &B) {
+      if (A.Ts != B.Ts)
+        return A.Ts < B.Ts;
+      return A.Dur > B.Dur;
+    });
+
+    struct Frame {
+      const Event *E;
+      int64_t ChildrenUs;
+    };
+    SmallVector<Frame, 0> Stack;
+    std::string Path;
+    auto Pop = [&] {
+      Frame F = Stack.pop_back_val();
+      Folded[Path] += std::max<int64_t>(F.E->Dur - F.ChildrenUs, 0);
+      if (!Stack.empty())
+        Stack.back().ChildrenUs += F.E->Dur;
+      size_t Sep = Path.rfind(';');
+      Path.resize(Sep == std::string::npos ? 0 : Sep);
+    };
+    for (const Event &E : Events) {
+      while (!Stack.empty() &&
+             Stack.back().E->Ts + Stack.back().E->Dur <= E.Ts)
+        Pop();
+      if (!Stack.empty())
+        Path += ';';
+      Path += getFrame(E);
+      Stack.push_back({&E, 0});
+    }
+    while (!Stack.empty())
+      Pop();
+  }
+}
+
+static void printTable(const StringMap<Total> &Totals, raw_ostream &OS) {
+  std::vector<const StringMapEntry<Total> *> Sorted;
+  Sorted.reserve(Totals.size());
+  for (const StringMapEntry<Total> &E : Totals)
+    Sorted.push_back(&E);
+  llvm::sort(Sorted, [](const auto *A, const auto *B) {
+    if (A->getValue().DurUs != B->getValue().DurUs)
+      return A->getValue().DurUs > B->getValue().DurUs;
+    return A->getKey() < B->getKey();
+  });
+  if (Top != 0 && Sorted.size() > Top)
+    Sorted.resize(Top);
+
+  OS << "  Total (ms)      Count   Traces   Avg (ms)  Event\n";
+  for (const StringMapEntry<Total> *E : Sorted) {
+    const Total &T = E->getValue();
+    OS << format("%12.1f %10llu %8llu %10.3f  ", T.DurUs / 1000.0,
+                 (unsigned long long)T.Count, (unsigned long long)T.Traces,
+                 T.DurUs / 1000.0 / T.Count)
+       << E->getKey() << "\n";
+  }
+}
+
+static void printFolded(const StringMap<int64_t> &Folded, raw_ostream &OS) {
+  std::vector<const StringMapEntry<int64_t> *> Sorted;
+  Sorted.reserve(Folded.size());
+  for (const StringMapEntry<int64_t> &E : Folded)
+    Sorted.push_back(&E);
+  llvm::sort(Sorted, [](const auto *A, const auto *B) {
+    return A->getKey() < B->getKey();
+  });
+  for (const StringMapEntry<int64_t> *E : Sorted)
+    if (E->getValue() > 0)
+      OS << E->getKey() << " " << E->getValue() << "\n";
+}
+
+int main(int argc, const char *argv[]) {
+  InitLLVM X(argc, argv);
+
+  cl::HideUnrelatedOptions({&AggregateCategory, &getColorCategory()});
+  cl::ParseCommandLineOptions(argc, argv,
+                              "LLVM -ftime-trace profile aggregator\n");
+
+  StringMap<Total> Totals;
+  StringMap<int64_t> Folded;
+  for (size_t I = 0, N = InputFilenames.size(); I != N; ++I)
+    readTrace(InputFilenames[I], I, Totals, Folded);
+
+  std::error_code EC;
+  raw_fd_ostream OS(OutputFilename, EC, sys::fs::OF_TextWithCRLF);
+  if (EC)
+    exitWithError(EC.message(), OutputFilename);
+
+  if (Format == OutputFormat::Table)
+    printTable(Totals, OS);
+  else
+    printFolded(Folded, OS);
+}
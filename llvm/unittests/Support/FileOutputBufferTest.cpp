@@ -139,6 +139,22 @@ TEST(FileOutputBuffer, Test) {
   uint64_t File5Size;
   ASSERT_NO_ERROR(fs::file_size(Twine(File5), File5Size));
   ASSERT_EQ(File5Size, 8000ULL);
+  {
+    // Verify contents, and that no temporary file was left behind.
+    ErrorOr<std::unique_ptr<MemoryBuffer>> MB =
+        MemoryBuffer::getFile(File5, /*IsText=*/false,
+                              /*RequiresNullTerminator=*/false);
+    ASSERT_NO_ERROR(MB.getError());
+    EXPECT_EQ((*MB)->getBuffer().take_front(20), "AABBCCDDEEFFGGHHIIJJ");
+    EXPECT_EQ((*MB)->getBuffer().take_back(20), "AABBCCDDEEFFGGHHIIJJ");
+    std::error_code EC;
+    unsigned NumFiles = 0;
+    for (fs::directory_iterator I(TestDirectory, EC), E; I != E && !EC;
+         I.increment(EC))
+      ++NumFiles;
+    ASSERT_NO_ERROR(EC);
+    EXPECT_EQ(NumFiles, 1u);
+  }
   ASSERT_NO_ERROR(fs::remove(File5.str()));
 
   // TEST 6: Create an empty file.